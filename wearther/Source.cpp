@@ -2,8 +2,9 @@
 
 // -------------------- OpenGL & Image ----------------------
 #include <glad/glad.h>
-#define STB_IMAGE_IMPLEMENTATION
-#include "image.h"
+#include "loadTexture.h"
+#include "assetLoader.h"
+#include "textureAtlas.h"
 
 // -------------------- SDL -------------------------------
 #include <SDL.h>
@@ -25,61 +26,28 @@
 #include <vector>
 #include <chrono>
 #include <ctime>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
 
 // -------------------- Audio -----------------------------
 #include <SDL_mixer.h>
 #include "audio.h"
+#include "ambientStream.h"
 
 // -------------------- App Modules -----------------------
 #include "settings.h"
+#include "settingsStore.h"
 #include "Weather.h"
 #include "pomedoro.h"
+#include "weatherFetch.h"
+#include "profiler.h"
+#include "timerWheel.h"
+#include "layout.h"
+#include "bench.h"
 
 using json = nlohmann::json;
 
-// ==========================================================
-// TEXTURE LOADER (OpenGL)
-// ==========================================================
-static GLuint LoadTexture(const char* filename)
-{
-    if (!filename) {
-        std::cerr << "[Texture] filename is null\n";
-        return 0;
-    }
-
-    int width = 0, height = 0, channels = 0;
-    unsigned char* data =
-        stbi_load(filename, &width, &height, &channels, STBI_rgb_alpha);
-
-    if (!data) {
-        std::cerr << "[Texture] Failed to load " << filename << "\n";
-        return 0;
-    }
-
-    GLuint tex = 0;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glTexImage2D(
-        GL_TEXTURE_2D, 0, GL_RGBA8,
-        width, height, 0,
-        GL_RGBA, GL_UNSIGNED_BYTE, data
-    );
-
-    glGenerateMipmap(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
-
-    std::cout << "[Texture] Loaded " << filename
-        << " (" << width << "x" << height << ")\n";
-
-    return tex;
-}
-
 // ==========================================================
 // ROOT WINDOW 
 // ==========================================================
@@ -104,9 +72,11 @@ static void BeginRoot(ImGuiIO& io)
 // ==========================================================
 void RenderCustomTabs(int& activeTab)
 {
+    const TabBarLayout& lay = Layout_Get().tabs;
+
     // Rounded buttons
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 14.0f);
-    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(18, 12));
+    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, lay.rounding);
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, lay.framePadding);
 
     // Button colors
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.85f, 0.85f, 0.85f, 0.15f));
@@ -114,34 +84,33 @@ void RenderCustomTabs(int& activeTab)
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.20f, 0.20f, 0.20f, 0.90f));
 
     // Center tabs
-    float width = ImGui::GetWindowWidth();
-    ImGui::SetCursorPosX((width - 360) * 0.5f);
+    ImGui::SetCursorPosX(lay.firstX);
 
     // ---------------- Pomodoro ----------------
     ImGui::PushStyleColor(ImGuiCol_Text,
         activeTab == 0 ? ImVec4(0, 0, 0, 1) : ImVec4(0.4f, 0.4f, 0.4f, 1));
 
-    if (ImGui::Button("Pomodoro", ImVec2(110, 40)))
+    if (ImGui::Button("Pomodoro", lay.button))
         activeTab = 0;
 
     ImGui::PopStyleColor();
-    ImGui::SameLine();
+    ImGui::SameLine(0.0f, lay.spacing);
 
     // ---------------- Weather -----------------
     ImGui::PushStyleColor(ImGuiCol_Text,
         activeTab == 1 ? ImVec4(0, 0, 0, 1) : ImVec4(0.4f, 0.4f, 0.4f, 1));
 
-    if (ImGui::Button("Weather", ImVec2(110, 40)))
+    if (ImGui::Button("Weather", lay.button))
         activeTab = 1;
 
     ImGui::PopStyleColor();
-    ImGui::SameLine();
+    ImGui::SameLine(0.0f, lay.spacing);
 
     // ---------------- Settings ----------------
     ImGui::PushStyleColor(ImGuiCol_Text,
         activeTab == 2 ? ImVec4(0, 0, 0, 1) : ImVec4(0.4f, 0.4f, 0.4f, 1));
 
-    if (ImGui::Button("Settings", ImVec2(110, 40)))
+    if (ImGui::Button("Settings", lay.button))
         activeTab = 2;
 
     ImGui::PopStyleColor();
@@ -151,12 +120,103 @@ void RenderCustomTabs(int& activeTab)
     ImGui::PopStyleVar(2);
 }
 
+// ==========================================================
+// IDLE RENDERING
+// ==========================================================
+// Nothing on screen changes between input events except the clock and the
+// countdown, which both tick once per second. After a few frames without
+// input the loop sleeps in SDL_WaitEventTimeout until the next event, the
+// next wall-clock second or the next countdown tick. The fetch worker
+// pushes an SDL event when new weather arrives, which also wakes the loop.
+
+// Frames still rendered after the last event (lets ImGui settle hover /
+// active state, which can take a frame or two to show)
+static constexpr int ACTIVE_FRAMES_AFTER_EVENT = 3;
+
+static int MsUntilNextWake(bool countdownVisible)
+{
+    using namespace std::chrono;
+
+    // Next wall-clock second boundary (+1 ms so we land just past it)
+    long long nowMs = duration_cast<milliseconds>(
+        system_clock::now().time_since_epoch()).count();
+    int wait = (int)(1000 - nowMs % 1000) + 1;
+
+    // Next countdown redraw while its tab is drawn, or the next timer on the
+    // wheel (session changes, reminders), whichever is first
+    auto wake = std::min(Pomodoro_NextWake(countdownVisible), Timers_NextDue());
+    if (wake != steady_clock::time_point::max()) {
+        auto untilWake = duration_cast<milliseconds>(wake - steady_clock::now()).count();
+        wait = (int)std::min<long long>(wait, std::max(0LL, (long long)untilWake) + 1);
+    }
+
+    return std::max(wait, 0);
+}
+
+// ==========================================================
+// IMAGE DECODE SCALE
+// ==========================================================
+// Images are decoded once, so decode them for the largest size the window
+// can reach: any connected display filled edge to edge, at that display's
+// pixel density. The layout scales the design canvas by the smaller of the
+// two ratios, which bounds it. Capped so an 8K panel doesn't decode the
+// stopwatch at 4000 px.
+static constexpr float MAX_DECODE_SCALE = 4.0f;
+
+static float MaxDecodeScale(SDL_Window* window)
+{
+    int w = 0, h = 0, pw = 0, ph = 0;
+    SDL_GetWindowSize(window, &w, &h);
+    SDL_GL_GetDrawableSize(window, &pw, &ph);
+    float density = (w > 0 && pw > 0) ? (float)pw / w : 1.0f;
+
+    // Other displays' density relative to this one, from their DPI
+    float currentDpi = 0.0f;
+    int current = SDL_GetWindowDisplayIndex(window);
+    if (current < 0 || SDL_GetDisplayDPI(current, &currentDpi, nullptr, nullptr) != 0) {
+        currentDpi = 0.0f;
+    }
+
+    float best = density;
+    for (int i = 0; i < SDL_GetNumVideoDisplays(); ++i)
+    {
+        SDL_Rect bounds;
+        if (SDL_GetDisplayBounds(i, &bounds) != 0) continue;
+
+        float fit = std::min(bounds.w / LAYOUT_DESIGN_WIDTH, bounds.h / LAYOUT_DESIGN_HEIGHT);
+        float dpi = 0.0f;
+        float d = density;
+        if (currentDpi > 0.0f && SDL_GetDisplayDPI(i, &dpi, nullptr, nullptr) == 0 && dpi > 0.0f) {
+            d = density * dpi / currentDpi;
+        }
+        best = std::max(best, fit * d);
+    }
+    return std::clamp(best, 1.0f, MAX_DECODE_SCALE);
+}
+
 // ==========================================================
 // MAIN ENTRY POINT
 // ==========================================================
-int main(int, char**)
+int main(int argc, char** argv)
 {
+    // ---------------- Benchmarks (opt-in) ----------------
+    const char* bench = Bench_FromArgs(argc, argv);
+    if (bench) {
+        int rc = Bench_RunHeadless(bench);
+        if (rc >= 0) return rc;
+        if (!Bench_IsUi(bench)) {
+            std::cerr << "[Bench] Unknown benchmark: " << bench << "\n";
+            return 1;
+        }
+    }
+    bool uiBench = bench != nullptr;
+
     // ---------------- SDL Init ----------------
+    // Per-monitor DPI aware on Windows: the window is sized in scaled units
+    // and the GL drawable gets the real pixels instead of a stretched bitmap
+    SDL_SetHint(SDL_HINT_WINDOWS_DPI_AWARENESS, "permonitorv2");
+    SDL_SetHint(SDL_HINT_WINDOWS_DPI_SCALING, "1");
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
         std::cerr << "SDL Init failed\n";
         return -1;
@@ -170,12 +230,12 @@ int main(int, char**)
         "ClockIT",
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
-        1280, 720,
-        SDL_WINDOW_OPENGL
+        (int)LAYOUT_DESIGN_WIDTH, (int)LAYOUT_DESIGN_HEIGHT,
+        SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI
     );
 
-    SDL_SetWindowResizable(window, SDL_FALSE);
-
+    // Below half the design size the 6x text no longer fits
+    SDL_SetWindowMinimumSize(window, (int)LAYOUT_DESIGN_WIDTH / 2, (int)LAYOUT_DESIGN_HEIGHT / 2);
 
     SDL_GLContext gl_context = SDL_GL_CreateContext(window);
     SDL_GL_MakeCurrent(window, gl_context);
@@ -189,13 +249,16 @@ int main(int, char**)
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    // ---------------- Settings ----------------
+    SettingsStore_Load();
+    AppSettings& settings = SettingsStore_Get();
+
     // ---------------- Audio Init --------------
     if (!Audio_Init()) return 1;
 
-    Mix_Chunk* rain = Audio_LoadSfx("assets/audio/rain.wav");
-    Mix_Chunk* alarm = Audio_LoadSfx("assets/audio/alarm.wav");
-
-    std::vector<Mix_Chunk*> audiofiles{ rain, alarm };
+    // ---------------- Weather Worker ----------
+    if (uiBench) Bench_UiStart(bench);
+    else WeatherFetch_Start();
 
     // ---------------- ImGui Init --------------
     IMGUI_CHECKVERSION();
@@ -208,90 +271,229 @@ int main(int, char**)
     ImGui_ImplOpenGL3_Init("#version 330");
 
     // ---------------- Resources ----------------
-    GLuint bgtex = LoadTexture("assets/images/background.jpg");
-    GLuint icontex = LoadTexture("assets/images/thunderstorm.png");
-    GLuint clockTex = LoadTexture("assets/images/stopwatch.png");
-    GLuint arrowTex = LoadTexture("assets/images/arrow.jpg");
-    GLuint startTex = LoadTexture("assets/images/start.png");
-    GLuint stopTex = LoadTexture("assets/images/stop.png");
-    GLuint pauseTex = LoadTexture("assets/images/pause.png");
-    GLuint resetTex = LoadTexture("assets/images/reset.png");
+    // Decoded in parallel; textures are uploaded here as each one finishes.
+    // Sizes = largest size each image is drawn at, in design units times
+    // the largest scale the window can reach; bigger sources are
+    // downsampled before upload. Icons are packed into one atlas texture
+    // (order must match UiIcon); buttons keep their raw size.
+    const float decodeScale = MaxDecodeScale(window);
+    auto px = [decodeScale](int designSize) { return (int)std::ceil(designSize * decodeScale); };
+    std::cout << "[Layout] Decoding images for up to " << decodeScale << "x the design size\n";
+
+    AssetManifest manifest;
+    manifest.textures = {
+        { "assets/images/background.jpg", px(1280), px(720) },
+        { "assets/images/stopwatch.png", px(500), px(500) },
+    };
+    manifest.icons = {
+        { "assets/images/thunderstorm.png", px(300), px(200) },
+        { "assets/images/arrow.jpg", px(150), px(150) },
+        { "assets/images/start.png" },
+        { "assets/images/stop.png" },
+        { "assets/images/pause.png" },
+        { "assets/images/reset.png" },
+    };
+    manifest.sounds = {
+        "assets/audio/alarm.wav",
+    };
+    manifest.fonts = {
+        "assets/fonts/ScienceGothic-Medium.ttf",
+    };
+
+    LoadedAssets assets = Assets_LoadAll(manifest);
+
+    // No recordings ship for the ambient presets, so they are synthesized
+    // (order must match the Settings preset list)
+    std::vector<AmbientStream*> ambient = {
+        Ambient_OpenSynth(SYNTH_RAIN),
+        Ambient_OpenSynth(SYNTH_SURF),
+        Ambient_OpenSynth(SYNTH_WIND),
+    };
+
+    Atlas_Build(assets.icons);
+    assets.icons.clear();
+    Texture_ReleaseStaging();
+    Texture_ReportBudget();
+    Audio_ReportMemory();
+
+    std::vector<GLuint>& textures = assets.textures;
+    std::vector<Mix_Chunk*>& audiofiles = assets.sounds;
+    Ambient_SetPresets(ambient);
+    Ambient_SelectPreset(settings.sound.preset);
+    Audio_SetVolume(settings.sound.volume);
+    if (!settings.sound.enabled) {
+        Audio_MuteAll();
+    }
 
     io.Fonts->AddFontDefault();
-    ImFont* bigFont = io.Fonts->AddFontFromFileTTF(
-        "assets/fonts/ScienceGothic-Medium.ttf",
-        8.0f
-    );
 
-    std::vector<GLuint> textures{
-        bgtex, icontex, clockTex, arrowTex,
-        startTex, stopTex, pauseTex, resetTex
+    // ImGui takes ownership of the font bytes, so hand it an IM_ALLOC copy.
+    // 8 px is only the base size: ImGui bakes glyphs on demand at the final
+    // size (window font scale x framebuffer density), so scaled text stays
+    // sharp at any window size.
+    ImFont* bigFont = nullptr;
+    std::vector<unsigned char>& fontBytes = assets.fonts[0];
+    if (!fontBytes.empty()) {
+        void* fontData = IM_ALLOC(fontBytes.size());
+        memcpy(fontData, fontBytes.data(), fontBytes.size());
+        bigFont = io.Fonts->AddFontFromMemoryTTF(fontData, (int)fontBytes.size(), 8.0f);
+    }
+    else {
+        bigFont = io.Fonts->AddFontFromFileTTF(
+            "assets/fonts/ScienceGothic-Medium.ttf",
+            8.0f
+        );
+    }
+
+    // ---------------- Layout ----------------
+    // Widget rects are only recomputed when the window size or DPI changes
+    auto relayout = [&]()
+    {
+        int w = 0, h = 0, pw = 0, ph = 0;
+        SDL_GetWindowSize(window, &w, &h);
+        SDL_GL_GetDrawableSize(window, &pw, &ph);
+        Layout_Update(w, h, pw, ph);
     };
 
+    Layout_Init(textures.size() > 1 ? textures[1] : 0);
+    relayout();
+
     // ---------------- App State ----------------
     bool running = true;
     SDL_Event e;
     int activeTab = 0;
+    int activeFrames = ACTIVE_FRAMES_AFTER_EVENT;
+
+    Profiler_Init();
+
+    auto handleEvent = [&](const SDL_Event& ev)
+    {
+        if (!Profiler_HandleEvent(ev))
+            ImGui_ImplSDL2_ProcessEvent(&ev);
+        if (ev.type == SDL_QUIT)
+            running = false;
+        if (ev.type == SDL_WINDOWEVENT &&
+            (ev.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ||
+             ev.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED))
+            relayout();
+        activeFrames = ACTIVE_FRAMES_AFTER_EVENT;
+    };
 
     // ======================================================
     // MAIN LOOP
     // ======================================================
     while (running)
     {
-        while (SDL_PollEvent(&e)) {
-            ImGui_ImplSDL2_ProcessEvent(&e);
-            if (e.type == SDL_QUIT)
-                running = false;
+        // -------- Idle: sleep until something can change --------
+        bool woken = false;
+        if (activeFrames <= 0 && !uiBench)
+            woken = SDL_WaitEventTimeout(&e, MsUntilNextWake(activeTab == 0)) != 0;
+
+        Profiler_BeginFrame();
+        bool refreshing = WeatherFetch_IsRefreshing();
+
+        {
+            ProfileScope scope(PHASE_EVENTS);
+            if (woken)
+                handleEvent(e);
+            while (SDL_PollEvent(&e))
+                handleEvent(e);
         }
 
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplSDL2_NewFrame();
-        ImGui::NewFrame();
+        // Dispatch due timers (Pomodoro sessions, reminders) on this thread
+        Timers_Advance(std::chrono::steady_clock::now());
 
-        // -------- Root Content --------
-        BeginRoot(io);
+        // -------- Build UI --------
+        {
+            ProfileScope scope(PHASE_TABS);
 
-        ImGui::SetWindowFontScale(6.0f);
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplSDL2_NewFrame();
+            ImGui::NewFrame();
 
-        if (activeTab == 0)
-            PomederoTab(io, textures, bigFont, audiofiles);
-        else if (activeTab == 1)
-            weathertab(io, textures, bigFont);
-        else
-            Settingtab(io, textures, bigFont, audiofiles);
+            // -------- Root Content --------
+            BeginRoot(io);
 
-        // -------- Top Tabs (drawn LAST) --------
-        ImGui::SetNextWindowPos(ImVec2(0, 6), ImGuiCond_Always);
-        ImGui::SetNextWindowSize(ImVec2(io.DisplaySize.x, 80), ImGuiCond_Always);
+            const AppLayout& layout = Layout_Get();
+            ImGui::SetWindowFontScale(layout.rootFontScale);
 
-        ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 6));
-        ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0));
+            if (activeTab == 0)
+                PomederoTab(io, textures, bigFont, audiofiles);
+            else if (activeTab == 1)
+                weathertab(io, textures, bigFont);
+            else
+                Settingtab(io, textures, bigFont, audiofiles);
 
-        ImGui::Begin("Tabs", nullptr,
-            ImGuiWindowFlags_NoDecoration |
-            ImGuiWindowFlags_NoMove |
-            ImGuiWindowFlags_NoResize |
-            ImGuiWindowFlags_NoBackground |
-            ImGuiWindowFlags_NoNavFocus |
-            ImGuiWindowFlags_NoFocusOnAppearing
-        );
+            // -------- Top Tabs (drawn LAST) --------
+            ImGui::SetNextWindowPos(layout.tabs.window.pos, ImGuiCond_Always);
+            ImGui::SetNextWindowSize(layout.tabs.window.size, ImGuiCond_Always);
+
+            ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, layout.tabs.padding));
+            ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0));
+
+            ImGui::Begin("Tabs", nullptr,
+                ImGuiWindowFlags_NoDecoration |
+                ImGuiWindowFlags_NoMove |
+                ImGuiWindowFlags_NoResize |
+                ImGuiWindowFlags_NoBackground |
+                ImGuiWindowFlags_NoNavFocus |
+                ImGuiWindowFlags_NoFocusOnAppearing
+            );
 
-        RenderCustomTabs(activeTab);
+            ImGui::SetWindowFontScale(layout.tabs.fontScale);
+            RenderCustomTabs(activeTab);
 
-        ImGui::End();
-        ImGui::PopStyleColor();
-        ImGui::PopStyleVar();
+            ImGui::End();
+            ImGui::PopStyleColor();
+            ImGui::PopStyleVar();
 
-        ImGui::End(); // END ROOT
+            ImGui::End(); // END ROOT
+
+            Profiler_DrawOverlay();
+        }
 
         // -------- Render --------
-        ImGui::Render();
-        glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
+        {
+            ProfileScope scope(PHASE_IMGUI_RENDER);
+            ImGui::Render();
+        }
+
+        // Framebuffer pixels, not window units (they differ on high-DPI)
+        glViewport(0, 0,
+            (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x),
+            (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y));
         glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        SDL_GL_SwapWindow(window);
+
+        {
+            ProfileScope scope(PHASE_GL_DRAW);
+            Profiler_BeginGpu();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            Profiler_EndGpu();
+        }
+
+        {
+            ProfileScope scope(PHASE_SWAP);
+            SDL_GL_SwapWindow(window);
+        }
+
+        // Sampled at both ends so a refresh that starts or ends mid-frame counts
+        refreshing = refreshing || WeatherFetch_IsRefreshing();
+        Profiler_MarkBackgroundWork(refreshing);
+        Profiler_EndFrame();
+
+        if (uiBench && !Bench_UiFrame(refreshing))
+            running = false;
+
+        if (activeFrames > 0)
+            activeFrames--;
     }
 
+    int exitCode = uiBench ? Bench_UiFinish() : 0;
+
+    Profiler_Shutdown();
+    WeatherFetch_Stop();
+    Audio_Shutdown();
+    SettingsStore_Shutdown();
     SDL_Quit();
-    return 0;
+    return exitCode;
 }
@@ -11,27 +11,100 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <cmath>
+#include <ctime>
 
 #include "http.h"
 #include "time.h"
+#include "weatherFetch.h"
+#include "textureAtlas.h"
+#include "cachedLabel.h"
+#include "layout.h"
 
 
 
 
-// LOCATION CACHE
-static bool locationLoaded = false;
-static loc1 cachedLocation;
-static double lastLocationFetch = 0.0; // fetch every minute
-
-// WEATHER CACHE
-static bool weatherLoaded = false;
-static climate cachedWeather;
-static double lastWeatherFetch = 0.0;
-
 // TIME CACHE (UI ONLY)
 static std::string currentTime = "00:00:00";
-static double lastTimeUpdate = 0.0;
-std::string city = "unknown";
+static std::time_t lastTimeSecond = 0;
+
+// Temperature + wind text, reformatted only when a value changes
+static CachedLabel weatherLabel;
+
+// "Saved forecast from 14:05" while the data is still the on-disk copy
+static CachedLabel staleLabel;
+static int64_t staleFetchedAt = -1;
+static std::tm staleLocal{};
+
+// Positions, sizes and font scales live in layout.cpp (WeatherLayout)
+
+
+// -----------------------------------------------------------
+// FORECAST STRIP (draws straight from the snapshot's
+// preformatted arrays: no strings built, nothing allocated)
+// -----------------------------------------------------------
+static void DrawForecastStrip(ImGuiIO& io, const WeatherLayout& lay, const ForecastStrip& strip)
+{
+    if (strip.count == 0) return;
+
+    float width = lay.stripCellWidth * strip.count;
+    ImVec2 origin((io.DisplaySize.x - width) * 0.5f, lay.stripY);
+
+    ImGui::SetNextWindowPos(origin);
+    ImGui::SetNextWindowSize({ width, lay.stripHeight });
+    ImGui::Begin("Forecast1", nullptr,
+        ImGuiWindowFlags_NoDecoration |
+        ImGuiWindowFlags_NoBackground |
+        ImGuiWindowFlags_NoInputs |
+        ImGuiWindowFlags_NoMove |
+        ImGuiWindowFlags_NoResize |
+        ImGuiWindowFlags_NoScrollbar |
+        ImGuiWindowFlags_NoScrollWithMouse |
+        ImGuiWindowFlags_NoSavedSettings);
+
+    ImGui::SetWindowFontScale(lay.stripFontScale);
+
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    ImU32 textCol = IM_COL32(0, 0, 0, 255);
+    ImU32 lineCol = IM_COL32(40, 90, 160, 255);
+
+    dl->AddRectFilled(origin, { origin.x + width, origin.y + lay.stripHeight },
+        IM_COL32(255, 255, 255, 120), lay.stripRounding);
+
+    float lineTop = origin.y + lay.stripLineTop;
+    float lineBottom = origin.y + lay.stripHeight - lay.stripLineBottom;
+    float range = strip.maxTemp - strip.minTemp;
+
+    ImVec2 points[ForecastStrip::MAX_SLOTS];
+    int pointCount = 0;
+
+    for (int i = 0; i < strip.count; ++i)
+    {
+        float cx = origin.x + lay.stripCellWidth * (i + 0.5f);
+
+        ImVec2 hs = ImGui::CalcTextSize(strip.hourLabel[i]);
+        dl->AddText({ cx - hs.x * 0.5f, origin.y + lay.stripTextInset }, textCol, strip.hourLabel[i]);
+
+        ImVec2 ts = ImGui::CalcTextSize(strip.tempLabel[i]);
+        dl->AddText({ cx - ts.x * 0.5f, origin.y + lay.stripHeight - ts.y - lay.stripTextInset },
+            textCol, strip.tempLabel[i]);
+
+        float t = strip.temperature[i];
+        if (!std::isnan(t)) {
+            float k = range > 0.0f ? (t - strip.minTemp) / range : 0.5f;
+            points[pointCount++] = { cx, lineBottom - k * (lineBottom - lineTop) };
+        }
+    }
+
+    if (pointCount > 1) {
+        dl->AddPolyline(points, pointCount, lineCol, ImDrawFlags_None, lay.stripLineWidth);
+    }
+    for (int i = 0; i < pointCount; ++i) {
+        dl->AddCircleFilled(points[i], lay.stripPointRadius, lineCol);
+    }
+
+    ImGui::End();
+}
 
 
 
@@ -43,6 +116,9 @@ std::string city = "unknown";
 // -----------------------------------------------------------
 void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
 {
+    // Recomputed on resize only
+    const WeatherLayout& lay = Layout_Get().weather;
+
     // -----------------------------------------------------------
     // 1. BACKGROUND IMAGE 
     // -----------------------------------------------------------
@@ -71,26 +147,9 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
 
 
     // -----------------------------------------------------------
-    // 2. FETCH LOCATION EVERY 60 SECONDS
+    // 2. LATEST WEATHER SNAPSHOT (fetched on the background worker)
     // -----------------------------------------------------------
-    double now = ImGui::GetTime();
-
-    if (!locationLoaded || (now - lastLocationFetch >= 60.0)) {
-        cachedLocation = getpos();
-        locationLoaded = true;
-        lastLocationFetch = now;
-    }
-
-
-    // -----------------------------------------------------------
-    // 3. FETCH WEATHER EVERY 60 SECONDS
-    // -----------------------------------------------------------
-    if (!weatherLoaded || (now - lastWeatherFetch >= 60.0)) {
-        cachedWeather = Getweather(cachedLocation.lat, cachedLocation.lon);
-        city = GetCity();
-        weatherLoaded = true;
-        lastWeatherFetch = now;
-    }
+    std::shared_ptr<const WeatherSnapshot> snapshot = WeatherFetch_Latest();
 
 
     // -----------------------------------------------------------
@@ -109,14 +168,10 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
         ImGuiWindowFlags_NoScrollWithMouse |
         ImGuiWindowFlags_NoSavedSettings);
 
-    ImVec2 iconSize(300, 200);
-    ImVec2 iconPos(
-        (io.DisplaySize.x - iconSize.x) * 0.5f,
-        (io.DisplaySize.y - iconSize.y) * 0.5f - 100
-    );
-
-    ImGui::SetCursorPos(iconPos);
-    ImGui::Image((ImTextureID)(intptr_t)textures[1], iconSize);
+    const AtlasRegion& weatherIcon = Atlas_Get(ICON_WEATHER);
+    ImGui::SetCursorPos(lay.icon.pos);
+    ImGui::Image((ImTextureID)(intptr_t)weatherIcon.texture, lay.icon.size,
+        weatherIcon.uv0, weatherIcon.uv1);
 
     ImGui::End();
 
@@ -124,9 +179,17 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
     // -----------------------------------------------------------
     // 5. WEATHER TEXT
     // -----------------------------------------------------------
+    // Full-window overlays: they must never take focus or clicks, or they
+    // end up above the tab bar and swallow its buttons
+    ImGui::SetNextWindowPos({ 0, 0 });
+    ImGui::SetNextWindowSize(io.DisplaySize);
+
     ImGui::Begin("WeatherText1", nullptr,
         ImGuiWindowFlags_NoDecoration |
         ImGuiWindowFlags_NoBackground |
+        ImGuiWindowFlags_NoInputs |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoBringToFrontOnFocus |
         ImGuiWindowFlags_NoMove |
         ImGuiWindowFlags_NoResize |
         ImGuiWindowFlags_NoScrollbar |
@@ -135,23 +198,23 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
 
     ImGui::PushFont(bigFont);
     ImGui::PushStyleColor(ImGuiCol_Text, { 0, 0, 0, 1 });
-    ImGui::SetWindowFontScale(6.0f);
+    ImGui::SetWindowFontScale(lay.textFontScale);
 
-    double wind = cachedWeather.wind;
-    double temp = cachedWeather.temp;
+    double wind = snapshot->weather.wind;
+    double temp = snapshot->weather.temp;
 
-    std::string windStr = "Wind Speed: " + std::to_string(wind).substr(0, 3) + " km/hr";
-    std::string tempStr = "Temperature: " + std::to_string(temp).substr(0, 4) + " C";
+    // Keyed on the displayed precision (tenths), not the raw doubles
+    const CachedLabel& weatherText = Label_Update(weatherLabel,
+        Label_Key(std::lround(temp * 10.0), std::lround(wind * 10.0)),
+        "Temperature: %.1f C\nWind Speed: %.1f km/hr", temp, wind);
 
-    std::string weatherText = tempStr + "\n" + windStr;
-
-    ImVec2 ws = ImGui::CalcTextSize(weatherText.c_str());
+    ImVec2 ws = weatherText.size;
     ImGui::SetCursorPos({
         io.DisplaySize.x * 0.5f - ws.x * 0.5f,
-        io.DisplaySize.y * 0.5f + 30
+        lay.textY
         });
 
-    ImGui::Text("%s", weatherText.c_str());
+    ImGui::TextUnformatted(weatherText.text);
 
     ImGui::PopStyleColor();
     ImGui::PopFont();
@@ -161,6 +224,9 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
     // -----------------------------------------------------------
     // 6. TIME 
     // -----------------------------------------------------------
+    ImGui::SetNextWindowPos({ 0, 0 });
+    ImGui::SetNextWindowSize(io.DisplaySize);
+
     ImGui::Begin("Time1", nullptr,
         ImGuiWindowFlags_NoDecoration |
         ImGuiWindowFlags_NoBackground |
@@ -172,17 +238,17 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
         ImGuiWindowFlags_NoSavedSettings);
 
     ImGui::PushStyleColor(ImGuiCol_Text, { 0, 0, 0, 1 });
-    ImGui::SetWindowFontScale(6.0f);
+    ImGui::SetWindowFontScale(lay.timeFontScale);
 
-    if (now - lastTimeUpdate >= 1.0) {
+    // Keyed on the wall-clock second: frames may be a whole second apart
+    // when the main loop is idling
+    std::time_t nowSecond = std::time(nullptr);
+    if (nowSecond != lastTimeSecond) {
         currentTime = GetCurrentTimex();
-        lastTimeUpdate = now;
+        lastTimeSecond = nowSecond;
     }
 
-    ImGui::SetCursorPos({
-        (io.DisplaySize.x - 400) * 0.5f,
-        (io.DisplaySize.y - 200) * 0.5f + 250
-        });
+    ImGui::SetCursorPos(lay.timePos);
 
     ImGui::Text("%s", currentTime.c_str());
     ImGui::PopStyleColor();
@@ -192,9 +258,15 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
     // -----------------------------------------------------------
     // 7. CITY NAME 
     // -----------------------------------------------------------
+    ImGui::SetNextWindowPos({ 0, 0 });
+    ImGui::SetNextWindowSize(io.DisplaySize);
+
     ImGui::Begin("City1", nullptr,
         ImGuiWindowFlags_NoDecoration |
         ImGuiWindowFlags_NoBackground |
+        ImGuiWindowFlags_NoInputs |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoBringToFrontOnFocus |
         ImGuiWindowFlags_NoMove |
         ImGuiWindowFlags_NoResize |
         ImGuiWindowFlags_NoScrollbar |
@@ -203,13 +275,38 @@ void weathertab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont)
 
     ImGui::PushFont(bigFont);
     ImGui::PushStyleColor(ImGuiCol_Text, { 0, 0, 0, 1 });
-    ImGui::SetWindowFontScale(4.0f);
-
-    ImGui::SetCursorPos({ 20, 1 });
-    ImGui::Text("%s", city.c_str());
+    ImGui::SetWindowFontScale(lay.cityFontScale);
 
+    ImGui::SetCursorPos(lay.cityPos);
+    ImGui::Text("%s", snapshot->location.city.c_str());
     ImGui::PopStyleColor();
+
+    // Cached data stays on screen until the first refresh succeeds; say so
+    if (snapshot->fromCache)
+    {
+        if (snapshot->weatherFetchedAt != staleFetchedAt) {
+            std::time_t t = (std::time_t)snapshot->weatherFetchedAt;
+            localtime_s(&staleLocal, &t);
+            staleFetchedAt = snapshot->weatherFetchedAt;
+        }
+
+        ImGui::SetWindowFontScale(lay.staleFontScale);
+        const CachedLabel& staleText = Label_Update(staleLabel, Label_Key(staleFetchedAt),
+            "Saved forecast from %02d:%02d", staleLocal.tm_hour, staleLocal.tm_min);
+
+        ImGui::SetCursorPosX(lay.cityPos.x);
+        ImGui::PushStyleColor(ImGuiCol_Text, { 0.25f, 0.25f, 0.25f, 1 });
+        ImGui::TextUnformatted(staleText.text);
+        ImGui::PopStyleColor();
+    }
+
     ImGui::PopFont();
     ImGui::End();
+
+
+    // -----------------------------------------------------------
+    // 8. HOURLY FORECAST
+    // -----------------------------------------------------------
+    DrawForecastStrip(io, lay, snapshot->strip);
 }
 
@@ -0,0 +1,587 @@
+// ============================================================================
+// Streaming Ambient Loops
+// ============================================================================
+// reader thread:  file -> SDL_AudioStream (to float, device rate) -> ring
+// audio thread:   rings -> crossfade -> the Mix_HookMusic buffer
+//                 (volume and mute are the post-mix gain stage in audio.cpp)
+//
+// The ring is single-producer/single-consumer with monotonic read/write
+// counters, so neither side ever blocks the other. The UI thread only ever
+// stores atomics (requested stream, playing); the feeder owns the
+// crossfade state, except while Ambient_Close has it unhooked.
+
+#include "ambientStream.h"
+#include "noiseSynth.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// About half a second of device audio, rounded up to a power of two
+static constexpr double RING_SECONDS = 0.5;
+
+// How often the reader checks for free space (a fraction of the ring)
+static constexpr int READER_SLEEP_MS = 10;
+
+// Source frames read from disk per refill step
+static constexpr int READ_FRAMES = 4096;
+
+// Preset changes fade the old stream out and the new one in over this long
+static constexpr int CROSSFADE_MS = 1500;
+
+// Current stream plus up to three still fading out after quick switches
+static constexpr int MAX_VOICES = 4;
+
+// Feeder scratch size; longer callbacks are processed in blocks
+static constexpr int BLOCK_FRAMES = 1024;
+
+// ============================================================================
+// RING BUFFER
+// ============================================================================
+
+struct PcmRing
+{
+    std::vector<Uint8> data;            // capacity is a power of two
+    size_t mask = 0;
+    std::atomic<size_t> readPos{ 0 };   // advanced by the audio thread
+    std::atomic<size_t> writePos{ 0 };  // advanced by the reader thread
+
+    void Allocate(size_t minBytes)
+    {
+        size_t capacity = 1;
+        while (capacity < minBytes) capacity <<= 1;
+        data.assign(capacity, 0);
+        mask = capacity - 1;
+    }
+
+    size_t Available() const
+    {
+        return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_relaxed);
+    }
+
+    size_t Free() const
+    {
+        return data.size() - (writePos.load(std::memory_order_relaxed) - readPos.load(std::memory_order_acquire));
+    }
+
+    // Producer side; caller checked Free()
+    void Write(const Uint8* src, size_t n)
+    {
+        size_t w = writePos.load(std::memory_order_relaxed);
+        size_t at = w & mask;
+        size_t first = std::min(n, data.size() - at);
+        std::memcpy(data.data() + at, src, first);
+        std::memcpy(data.data(), src + first, n - first);
+        writePos.store(w + n, std::memory_order_release);
+    }
+};
+
+// ============================================================================
+// STREAM
+// ============================================================================
+
+struct AmbientStream
+{
+    std::string path;
+    FILE* file = nullptr;
+    long dataStart = 0;
+    long dataBytes = 0;
+    long dataPos = 0;           // bytes into the data chunk
+    int srcFrameBytes = 0;
+
+    SDL_AudioStream* converter = nullptr;
+    PcmRing ring;
+    NoiseSynth* synth = nullptr;    // procedural: rendered in the feeder, no file
+    size_t decodedBytes = 0;
+
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> closing{ false };     // feeder must let go of it
+    std::atomic<uint64_t> underruns{ 0 };
+    std::thread reader;
+};
+
+// Device format, from Mix_QuerySpec
+static int deviceFrequency = 0;
+static Uint16 deviceFormat = 0;
+static int deviceChannels = 0;
+
+// Written by the UI thread, read by the feeder
+static std::atomic<AmbientStream*> requested{ nullptr };
+static std::atomic<bool> playing{ false };
+
+// Bumped on entry and exit of every feeder call (odd = inside one)
+static std::atomic<uint64_t> feederCalls{ 0 };
+static bool feederHooked = false;       // UI thread: between Init and Shutdown
+
+// How long Ambient_Close waits for a feeder call before assuming the device
+// stopped calling back (unplugged) and unhooking it to take the voices back
+static constexpr int CLOSE_WAIT_MS = 500;
+
+// Feeder-owned crossfade state. fade runs 0..1 and is shaped to an
+// equal-power gain, so the mix stays level halfway through a crossfade.
+struct Voice {
+    AmbientStream* stream = nullptr;
+    float fade = 0.0f;
+};
+static Voice voices[MAX_VOICES];        // [0] = current, rest fading out
+static float fadeStep = 0.0f;           // per frame
+static std::vector<float> mixBuffer;    // BLOCK_FRAMES * channels, allocated in Init
+static std::vector<float> readBuffer;
+
+static std::vector<AmbientStream*> presets;
+
+static std::mutex streamsMutex;
+static std::vector<AmbientStream*> streams;
+
+// ============================================================================
+// WAV HEADER
+// ============================================================================
+
+static Uint32 ReadLE32(const Uint8* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((Uint32)p[3] << 24); }
+static Uint16 ReadLE16(const Uint8* p) { return (Uint16)(p[0] | (p[1] << 8)); }
+
+struct WavInfo
+{
+    SDL_AudioFormat format = 0;
+    int channels = 0;
+    int frequency = 0;
+    long dataStart = 0;
+    long dataBytes = 0;
+};
+
+// Walks the RIFF chunks for "fmt " and "data"; leaves the file anywhere
+static bool ParseWav(FILE* file, WavInfo& info)
+{
+    Uint8 header[12];
+    if (std::fread(header, 1, 12, file) != 12 ||
+        std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    bool haveFormat = false;
+    Uint8 chunk[8];
+    while (std::fread(chunk, 1, 8, file) == 8)
+    {
+        Uint32 size = ReadLE32(chunk + 4);
+        long body = std::ftell(file);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16)
+        {
+            Uint8 fmt[40] = {};
+            if (std::fread(fmt, 1, std::min<Uint32>(size, sizeof(fmt)), file) < 16) return false;
+
+            Uint16 tag = ReadLE16(fmt);
+            if (tag == 0xFFFE && size >= 26) tag = ReadLE16(fmt + 24);   // WAVE_FORMAT_EXTENSIBLE
+            info.channels = ReadLE16(fmt + 2);
+            info.frequency = (int)ReadLE32(fmt + 4);
+            int bits = ReadLE16(fmt + 14);
+
+            if (tag == 1 && bits == 8) info.format = AUDIO_U8;
+            else if (tag == 1 && bits == 16) info.format = AUDIO_S16LSB;
+            else if (tag == 1 && bits == 32) info.format = AUDIO_S32LSB;
+            else if (tag == 3 && bits == 32) info.format = AUDIO_F32LSB;
+            else return false;
+            haveFormat = true;
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0)
+        {
+            info.dataStart = body;
+            info.dataBytes = (long)size;
+            return haveFormat && info.channels > 0 && info.frequency > 0;
+        }
+
+        // Chunks are word-aligned
+        if (std::fseek(file, body + (long)size + (size & 1), SEEK_SET) != 0) return false;
+    }
+    return false;
+}
+
+// ============================================================================
+// READER THREAD
+// ============================================================================
+
+// Pushes up to READ_FRAMES source frames into the converter, looping at the
+// end of the data chunk
+static bool FeedConverter(AmbientStream& s, std::vector<Uint8>& raw)
+{
+    long want = std::min<long>((long)raw.size(), s.dataBytes - s.dataPos);
+    size_t got = std::fread(raw.data(), 1, (size_t)want, s.file);
+    got -= got % s.srcFrameBytes;
+    if (got == 0) {
+        // End of data (or a short read): wrap to the first sample, unless
+        // nothing at all can be read
+        if (s.dataPos == 0) return false;
+        s.dataPos = 0;
+        return std::fseek(s.file, s.dataStart, SEEK_SET) == 0;
+    }
+
+    s.dataPos += (long)got;
+    if (s.dataPos >= s.dataBytes) {
+        s.dataPos = 0;
+        std::fseek(s.file, s.dataStart, SEEK_SET);
+    }
+    return SDL_AudioStreamPut(s.converter, raw.data(), (int)got) == 0;
+}
+
+static void ReaderMain(AmbientStream* s)
+{
+    std::vector<Uint8> raw((size_t)READ_FRAMES * s->srcFrameBytes);
+
+    const size_t frameBytes = sizeof(float) * deviceChannels;
+    std::vector<Uint8> converted((size_t)READ_FRAMES * frameBytes);
+
+    while (!s->stop.load())
+    {
+        // Top the ring up in converter-sized steps
+        while (s->ring.Free() >= converted.size() && !s->stop.load())
+        {
+            if (SDL_AudioStreamAvailable(s->converter) < (int)converted.size()) {
+                if (!FeedConverter(*s, raw)) {
+                    std::cerr << "[Audio] Read error streaming " << s->path << "\n";
+                    return;
+                }
+                continue;
+            }
+
+            int n = SDL_AudioStreamGet(s->converter, converted.data(), (int)converted.size());
+            if (n <= 0) break;
+            s->ring.Write(converted.data(), (size_t)n);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(READER_SLEEP_MS));
+    }
+}
+
+// ============================================================================
+// MUSIC HOOK (audio thread)
+// ============================================================================
+
+// Starts fading `want` in; the current voice moves to a fade-out slot. If it
+// is already fading out it is brought back from where it is.
+static void SwitchVoice(AmbientStream* want)
+{
+    int slot = 0;
+    for (int i = 1; i < MAX_VOICES; ++i) {
+        if (voices[i].stream == want && want) slot = i;
+    }
+    Voice incoming = slot ? voices[slot] : Voice{ want, 0.0f };
+    if (slot) voices[slot] = Voice{};
+
+    // Quietest fade-out slot makes room for the outgoing voice
+    if (voices[0].stream) {
+        int target = 1;
+        for (int i = 1; i < MAX_VOICES; ++i) {
+            if (!voices[i].stream) { target = i; break; }
+            if (voices[i].fade < voices[target].fade) target = i;
+        }
+        voices[target] = voices[0];
+    }
+    voices[0] = incoming;
+}
+
+// Pops up to `samples` floats from the ring (zero-filled on underrun), or
+// synthesizes them
+static void ReadVoice(AmbientStream* s, float* dst, size_t samples)
+{
+    if (s->synth) {
+        Synth_Render(s->synth, dst, (int)(samples / deviceChannels), deviceChannels);
+        return;
+    }
+
+    PcmRing& ring = s->ring;
+    size_t want = samples * sizeof(float);
+    size_t n = std::min(ring.Available(), want);
+    if (n < want) {
+        s->underruns.fetch_add(1, std::memory_order_relaxed);
+        std::memset((Uint8*)dst + n, 0, want - n);
+    }
+
+    // The wrap point is float-aligned because the capacity is a power of two
+    size_t r = ring.readPos.load(std::memory_order_relaxed);
+    size_t at = r & ring.mask;
+    size_t first = std::min(n, ring.data.size() - at);
+    std::memcpy(dst, ring.data.data() + at, first);
+    std::memcpy((Uint8*)dst + first, ring.data.data(), n - first);
+    ring.readPos.store(r + n, std::memory_order_release);
+}
+
+static void MixBlock(Uint8* out, int frames)
+{
+    const int channels = deviceChannels;
+    const size_t samples = (size_t)frames * channels;
+    float* mix = mixBuffer.data();
+    float* in = readBuffer.data();
+    std::fill(mix, mix + samples, 0.0f);
+
+    for (int v = 0; v < MAX_VOICES; ++v)
+    {
+        Voice& voice = voices[v];
+        if (!voice.stream) continue;
+
+        ReadVoice(voice.stream, in, samples);
+
+        float step = v == 0 ? fadeStep : -fadeStep;
+        for (int f = 0; f < frames; ++f)
+        {
+            voice.fade = std::clamp(voice.fade + step, 0.0f, 1.0f);
+            float gain = std::sin(voice.fade * 1.5707963f);
+            for (int c = 0; c < channels; ++c) {
+                mix[f * channels + c] += in[f * channels + c] * gain;
+            }
+        }
+
+        if (v > 0 && voice.fade <= 0.0f) voice = Voice{};
+    }
+
+    // `out` holds silence (plus nothing else yet); add with clipping
+    if (deviceFormat == AUDIO_F32SYS) {
+        float* dst = (float*)out;
+        for (size_t i = 0; i < samples; ++i) dst[i] += mix[i];
+    }
+    else {
+        Sint16* dst = (Sint16*)out;
+        for (size_t i = 0; i < samples; ++i) {
+            float x = dst[i] + mix[i] * 32767.0f;
+            dst[i] = (Sint16)std::clamp(x, -32768.0f, 32767.0f);
+        }
+    }
+}
+
+static void SDLCALL AmbientFeeder(void*, Uint8* out, int len)
+{
+    feederCalls.fetch_add(1);
+
+    // Let go of streams being closed before touching any ring
+    for (Voice& voice : voices) {
+        if (voice.stream && voice.stream->closing.load()) voice = Voice{};
+    }
+
+    AmbientStream* want = requested.load();
+    if (want && want->closing.load()) want = nullptr;
+    if (want != voices[0].stream) SwitchVoice(want);
+
+    if (playing.load(std::memory_order_relaxed))
+    {
+        const int frameBytes = SDL_AUDIO_BITSIZE(deviceFormat) / 8 * deviceChannels;
+        int frames = len / frameBytes;
+        while (frames > 0) {
+            int n = std::min(frames, BLOCK_FRAMES);
+            MixBlock(out, n);
+            out += n * frameBytes;
+            frames -= n;
+        }
+    }
+
+    feederCalls.fetch_add(1);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+void Ambient_Init()
+{
+    if (!Mix_QuerySpec(&deviceFrequency, &deviceFormat, &deviceChannels)) {
+        std::cerr << "[Audio] Ambient streaming needs an open audio device\n";
+        return;
+    }
+    if (deviceFormat != AUDIO_S16SYS && deviceFormat != AUDIO_F32SYS) {
+        std::cerr << "[Audio] Ambient streaming needs S16 or F32 output\n";
+        deviceFrequency = 0;
+        return;
+    }
+
+    fadeStep = 1000.0f / (CROSSFADE_MS * (float)deviceFrequency);
+    mixBuffer.assign((size_t)BLOCK_FRAMES * deviceChannels, 0.0f);
+    readBuffer.assign((size_t)BLOCK_FRAMES * deviceChannels, 0.0f);
+    Mix_HookMusic(AmbientFeeder, nullptr);
+    feederHooked = true;
+}
+
+void Ambient_Shutdown()
+{
+    // Mix_HookMusic takes the mixer lock, so no feeder call is running after it
+    Mix_HookMusic(nullptr, nullptr);
+    feederHooked = false;
+    playing.store(false);
+    requested.store(nullptr);
+    presets.clear();
+    for (Voice& voice : voices) voice = Voice{};
+
+    std::vector<AmbientStream*> open;
+    {
+        std::lock_guard<std::mutex> lock(streamsMutex);
+        open = streams;
+    }
+    for (AmbientStream* s : open) {
+        Ambient_Close(s);
+    }
+}
+
+AmbientStream* Ambient_Open(const std::string& path)
+{
+    if (deviceFrequency == 0) return nullptr;
+
+    FILE* file = nullptr;
+    if (fopen_s(&file, path.c_str(), "rb") != 0 || !file) {
+        std::cerr << "[Audio] Failed to open " << path << "\n";
+        return nullptr;
+    }
+
+    WavInfo info;
+    if (!ParseWav(file, info) || info.dataBytes <= 0) {
+        std::cerr << "[Audio] " << path << " is not a streamable PCM WAV\n";
+        std::fclose(file);
+        return nullptr;
+    }
+
+    SDL_AudioStream* converter = SDL_NewAudioStream(
+        info.format, (Uint8)info.channels, info.frequency,
+        AUDIO_F32SYS, (Uint8)deviceChannels, deviceFrequency);
+    if (!converter) {
+        std::cerr << "[Audio] SDL_NewAudioStream error: " << SDL_GetError() << "\n";
+        std::fclose(file);
+        return nullptr;
+    }
+
+    AmbientStream* s = new AmbientStream();
+    s->path = path;
+    s->file = file;
+    s->dataStart = info.dataStart;
+    s->dataBytes = info.dataBytes;
+    s->srcFrameBytes = SDL_AUDIO_BITSIZE(info.format) / 8 * info.channels;
+    s->converter = converter;
+    std::fseek(file, s->dataStart, SEEK_SET);
+
+    s->ring.Allocate((size_t)(deviceFrequency * RING_SECONDS) * sizeof(float) * deviceChannels);
+
+    // Mix_LoadWAV would hold the whole file in the device format
+    const int deviceFrameBytes = SDL_AUDIO_BITSIZE(deviceFormat) / 8 * deviceChannels;
+    double frames = (double)info.dataBytes / s->srcFrameBytes;
+    s->decodedBytes = (size_t)(frames * deviceFrequency / info.frequency) * deviceFrameBytes;
+
+    s->reader = std::thread(ReaderMain, s);
+
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    streams.push_back(s);
+    return s;
+}
+
+AmbientStream* Ambient_OpenSynth(SynthKind kind)
+{
+    if (deviceFrequency == 0) return nullptr;
+
+    AmbientStream* s = new AmbientStream();
+    s->path = std::string("procedural ") + Synth_Name(kind);
+    s->synth = Synth_Create(kind, deviceFrequency);
+
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    streams.push_back(s);
+    return s;
+}
+
+void Ambient_Close(AmbientStream* stream)
+{
+    if (!stream) return;
+
+    // Every feeder call that starts from here on drops it from voices[], but
+    // a call already inside may still put it back. Wait until one call has
+    // both started and finished after the flag: past the call in flight (if
+    // any), the next even count.
+    AmbientStream* expected = stream;
+    requested.compare_exchange_strong(expected, nullptr);
+    stream->closing.store(true);
+
+    bool released = false;
+    if (feederHooked)
+    {
+        uint64_t calls = feederCalls.load();
+        uint64_t target = (calls + 3) & ~1ull;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CLOSE_WAIT_MS);
+        while (feederCalls.load() < target) {
+            if (std::chrono::steady_clock::now() > deadline) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        released = feederCalls.load() >= target;
+    }
+
+    // Not hooked, or the device stopped calling back: Mix_HookMusic takes the
+    // mixer lock, so with the hook removed the voices are ours to clear
+    if (!released) {
+        if (feederHooked) Mix_HookMusic(nullptr, nullptr);
+        for (Voice& voice : voices) {
+            if (voice.stream == stream) voice = Voice{};
+        }
+        if (feederHooked) Mix_HookMusic(AmbientFeeder, nullptr);
+    }
+
+    std::replace(presets.begin(), presets.end(), stream, (AmbientStream*)nullptr);
+
+    stream->stop.store(true);
+    if (stream->reader.joinable()) stream->reader.join();
+
+    if (stream->converter) SDL_FreeAudioStream(stream->converter);
+    if (stream->file) std::fclose(stream->file);
+    Synth_Destroy(stream->synth);
+
+    {
+        std::lock_guard<std::mutex> lock(streamsMutex);
+        streams.erase(std::remove(streams.begin(), streams.end(), stream), streams.end());
+    }
+    delete stream;
+}
+
+void Ambient_Select(AmbientStream* stream)
+{
+    requested.store(stream);
+}
+
+void Ambient_SetPresets(const std::vector<AmbientStream*>& list)
+{
+    presets = list;
+}
+
+void Ambient_SelectPreset(int index)
+{
+    if (index >= 0 && index < (int)presets.size()) {
+        Ambient_Select(presets[index]);
+    }
+}
+
+void Ambient_Play()
+{
+    playing.store(true);
+}
+
+void Ambient_Pause()
+{
+    playing.store(false);
+}
+
+bool Ambient_IsPlaying()
+{
+    return playing.load() && requested.load() != nullptr;
+}
+
+std::vector<AmbientStreamInfo> Ambient_GetStreams()
+{
+    std::lock_guard<std::mutex> lock(streamsMutex);
+
+    std::vector<AmbientStreamInfo> out;
+    out.reserve(streams.size());
+    for (const AmbientStream* s : streams) {
+        if (s->synth) {
+            out.push_back({ s->path, Synth_StateBytes(), 0, 0, true });
+            continue;
+        }
+        out.push_back({ s->path, s->ring.data.size(), s->decodedBytes, s->underruns.load(), false });
+    }
+    return out;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <SDL_mixer.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "noiseSynth.h"
+
+// Long ambient loops (rain, surf, ...) streamed from disk instead of being
+// decoded whole into a Mix_Chunk like the short SFX. A reader thread per
+// stream keeps a bounded ring of float PCM at the device rate topped up; the audio
+// thread pulls from it through Mix_HookMusic and never touches the file or a
+// lock. The loop point is seamless: the reader just seeks back to the first
+// sample and keeps feeding the same converter. Switching streams crossfades.
+// The Settings presets are procedural streams (Ambient_OpenSynth), rendered
+// in the feeder with no file or reader thread behind them.
+
+struct AmbientStream;
+
+// Hook / unhook the music feeder (Audio_Init and Audio_Shutdown call these)
+void Ambient_Init();
+void Ambient_Shutdown();
+
+// PCM WAV, 8/16/32-bit integer or 32-bit float. Starts the reader thread and
+// returns nullptr if the file can't be streamed. Safe from worker threads.
+AmbientStream* Ambient_Open(const std::string& path);
+
+// Same kind of stream, but generated by noiseSynth in the feeder instead of
+// read from disk. This is how the rain / surf / wind presets are produced.
+AmbientStream* Ambient_OpenSynth(SynthKind kind);
+void Ambient_Close(AmbientStream* stream);
+
+// Which stream the feeder plays (nullptr = none). The previous one fades
+// out while this one fades in; returns at once.
+void Ambient_Select(AmbientStream* stream);
+
+// Soundscape presets, in the order the Settings list shows them (entries
+// may be nullptr if a stream failed to open)
+void Ambient_SetPresets(const std::vector<AmbientStream*>& list);
+void Ambient_SelectPreset(int index);
+
+void Ambient_Play();
+void Ambient_Pause();
+bool Ambient_IsPlaying();
+
+// No volume of its own: Audio_SetVolume / Audio_MuteAll ramp the output
+// gain stage in audio.cpp, which covers ambient and SFX alike.
+
+struct AmbientStreamInfo
+{
+    std::string path;
+    size_t ringBytes = 0;       // resident PCM
+    size_t decodedBytes = 0;    // what Mix_LoadWAV would have kept resident
+    uint64_t underruns = 0;     // callbacks the ring could not fill
+    bool procedural = false;    // ringBytes is the synth state
+};
+std::vector<AmbientStreamInfo> Ambient_GetStreams();
@@ -0,0 +1,171 @@
+// ============================================================================
+// Startup Asset Pipeline
+// ============================================================================
+// Worker threads decode images and WAVs, open ambient streams and read font
+// files in parallel. Decoded
+// images are handed to the GL thread through a queue and uploaded there while
+// the remaining decodes are still running.
+
+#include "assetLoader.h"
+#include "loadTexture.h"
+#include "audio.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// ============================================================================
+// UPLOAD QUEUE (workers -> GL thread)
+// ============================================================================
+
+struct PendingUpload {
+    size_t index;       // slot in LoadedAssets::textures
+    DecodedImage image;
+    bool ok;
+};
+
+struct UploadQueue {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<PendingUpload> items;
+};
+
+// ----------------------------------------------------------------------------
+// Read a whole file (fonts are handed to ImGui as memory)
+// ----------------------------------------------------------------------------
+static std::vector<unsigned char> ReadFileBytes(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "[Assets] Failed to open " << path << "\n";
+        return {};
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<unsigned char> bytes((size_t)size);
+    if (!file.read((char*)bytes.data(), size)) {
+        std::cerr << "[Assets] Failed to read " << path << "\n";
+        return {};
+    }
+    return bytes;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+LoadedAssets Assets_LoadAll(const AssetManifest& manifest)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    const size_t textureCount = manifest.textures.size();
+    const size_t iconCount = manifest.icons.size();
+    const size_t soundCount = manifest.sounds.size();
+    const size_t ambientCount = manifest.ambient.size();
+    const size_t fontCount = manifest.fonts.size();
+    const size_t jobCount = textureCount + iconCount + soundCount + ambientCount + fontCount;
+
+    LoadedAssets assets;
+    assets.textures.assign(textureCount, 0);
+    assets.icons.resize(iconCount);
+    assets.sounds.assign(soundCount, nullptr);
+    assets.ambient.assign(ambientCount, nullptr);
+    assets.fonts.resize(fontCount);
+
+    UploadQueue queue;
+    std::atomic<size_t> nextJob{ 0 };
+
+    // Jobs are numbered textures, icons, sounds, ambient, then fonts; each worker
+    // claims the next unclaimed job until none are left
+    auto workerMain = [&]()
+    {
+        for (;;)
+        {
+            size_t job = nextJob.fetch_add(1);
+            if (job >= jobCount) return;
+
+            if (job < textureCount)
+            {
+                const TextureRequest& req = manifest.textures[job];
+
+                PendingUpload upload{ job, {}, false };
+                upload.ok = Texture_Decode(req.path.c_str(),
+                    req.displayWidth, req.displayHeight, upload.image);
+
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.items.push_back(std::move(upload));
+                }
+                queue.ready.notify_one();
+            }
+            else if (job < textureCount + iconCount)
+            {
+                size_t i = job - textureCount;
+                const TextureRequest& req = manifest.icons[i];
+                // Atlas builds its own mips, so decode level 0 only
+                Texture_Decode(req.path.c_str(),
+                    req.displayWidth, req.displayHeight, assets.icons[i], false);
+            }
+            else if (job < textureCount + iconCount + soundCount)
+            {
+                size_t i = job - textureCount - iconCount;
+                assets.sounds[i] = Audio_LoadSfx(manifest.sounds[i]);
+            }
+            else if (job < textureCount + iconCount + soundCount + ambientCount)
+            {
+                size_t i = job - textureCount - iconCount - soundCount;
+                assets.ambient[i] = Ambient_Open(manifest.ambient[i]);
+            }
+            else
+            {
+                size_t i = job - textureCount - iconCount - soundCount - ambientCount;
+                assets.fonts[i] = ReadFileBytes(manifest.fonts[i]);
+            }
+        }
+    };
+
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    size_t workerCount = std::min<size_t>(hw, jobCount);
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(workerMain);
+    }
+
+    // GL thread: upload each texture as soon as it is decoded
+    for (size_t uploaded = 0; uploaded < textureCount; ++uploaded)
+    {
+        PendingUpload item;
+        {
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            queue.ready.wait(lock, [&] { return !queue.items.empty(); });
+            item = std::move(queue.items.front());
+            queue.items.pop_front();
+        }
+
+        if (item.ok) {
+            assets.textures[item.index] = Texture_Upload(item.image);
+        }
+    }
+
+    for (std::thread& t : workers) {
+        t.join();
+    }
+
+    Texture_ReleaseStaging();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "[Assets] Loaded " << jobCount << " assets on "
+        << workerCount << " threads in " << elapsed.count() << " ms\n";
+
+    return assets;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <glad/glad.h>
+#include <SDL_mixer.h>
+
+#include <string>
+#include <vector>
+
+#include "loadTexture.h"
+#include "ambientStream.h"
+
+// One image and the largest size it is drawn at (0 = keep native size)
+struct TextureRequest {
+    std::string path;
+    int displayWidth = 0;
+    int displayHeight = 0;
+};
+
+// Everything decoded at startup
+struct AssetManifest {
+    std::vector<TextureRequest> textures;
+    std::vector<TextureRequest> icons;      // decoded only, for the atlas
+    std::vector<std::string> sounds;        // short SFX, decoded resident
+    std::vector<std::string> ambient;       // long loops, streamed from disk
+    std::vector<std::string> fonts;
+};
+
+// Results in manifest order; failed entries are 0 / nullptr / empty
+struct LoadedAssets {
+    std::vector<GLuint> textures;
+    std::vector<DecodedImage> icons;
+    std::vector<Mix_Chunk*> sounds;
+    std::vector<AmbientStream*> ambient;
+    std::vector<std::vector<unsigned char>> fonts;   // raw TTF bytes
+};
+
+// Decodes every asset concurrently on a worker pool. Textures are uploaded on
+// the calling (GL) thread as soon as each decode finishes, so total time is
+// bounded by the slowest asset rather than the sum. Audio must be open.
+LoadedAssets Assets_LoadAll(const AssetManifest& manifest);
@@ -1,6 +1,249 @@
 // audio_system.cpp
 #include "audio.h"
+#include "ambientStream.h"
+#include "settingsStore.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <vector>
+
+// Resident SFX by path, for Audio_ReportMemory (loaded from asset workers)
+struct SfxInfo {
+    std::string path;
+    Mix_Chunk* chunk;
+};
+static std::mutex sfxMutex;
+static std::vector<SfxInfo> sfxRegistry;
+
+// ----------------------------------------------------------------------------
+// Output gain stage: a MIX_CHANNEL_POST effect, so it covers every channel
+// and the ambient feeder. The UI thread only stores the target; the effect
+// glides towards it per sample frame (one-pole, ~GAIN_SMOOTH_MS), which keeps
+// live slider drags and mute free of zipper noise and clicks.
+// ----------------------------------------------------------------------------
+static constexpr float GAIN_SMOOTH_MS = 15.0f;
+
+static std::atomic<float> volumeGain{ 1.0f };
+static std::atomic<bool> muted{ false };
+
+// Audio thread only
+static float currentGain = 1.0f;
+static float gainCoeff = 1.0f;
+static Uint16 outputFormat = 0;
+static int outputChannels = 0;
+
+static void SDLCALL GainEffect(int, void* stream, int len, void*)
+{
+    float target = muted.load(std::memory_order_relaxed) ? 0.0f
+        : volumeGain.load(std::memory_order_relaxed);
+
+    // Settled at unity: nothing to do
+    if (currentGain == 1.0f && target == 1.0f) return;
+
+    const int channels = outputChannels;
+    float g = currentGain;
+
+    if (outputFormat == AUDIO_F32SYS)
+    {
+        float* samples = (float*)stream;
+        int frames = len / (int)(sizeof(float) * channels);
+        for (int f = 0; f < frames; ++f) {
+            g += (target - g) * gainCoeff;
+            for (int c = 0; c < channels; ++c) samples[f * channels + c] *= g;
+        }
+    }
+    else
+    {
+        Sint16* samples = (Sint16*)stream;
+        int frames = len / (int)(sizeof(Sint16) * channels);
+        for (int f = 0; f < frames; ++f) {
+            g += (target - g) * gainCoeff;
+            for (int c = 0; c < channels; ++c) {
+                samples[f * channels + c] = (Sint16)std::lrint(samples[f * channels + c] * g);
+            }
+        }
+    }
+
+    // Snap once inaudibly close so the steady state stays on the fast path
+    if (std::fabs(g - target) < 1e-4f) g = target;
+    currentGain = g;
+}
+
+static void InstallGainStage()
+{
+    int frequency = 0;
+    Mix_QuerySpec(&frequency, &outputFormat, &outputChannels);
+    if (outputFormat != AUDIO_S16SYS && outputFormat != AUDIO_F32SYS) {
+        std::cout << "[Audio] No gain stage for this output format\n";
+        return;
+    }
+
+    gainCoeff = 1.0f - std::exp(-1000.0f / (GAIN_SMOOTH_MS * frequency));
+    currentGain = muted.load() ? 0.0f : volumeGain.load();
+    Mix_RegisterEffect(MIX_CHANNEL_POST, GainEffect, nullptr, nullptr);
+}
+
+// ----------------------------------------------------------------------------
+// Buffer auto-tuning. SDL2 has no underrun query, so a post-mix callback
+// watches the gaps between mixer callbacks: with the device double-buffered,
+// a gap longer than two buffer periods means it ran dry. Sizes are probed
+// from large to small and the smallest one with no late callbacks is kept
+// (remembered in the settings store); late callbacks during a run bump it up
+// for the next one.
+// ----------------------------------------------------------------------------
+static const int CHUNK_CANDIDATES[] = { 2048, 1024, 512, 256 };
+static constexpr Uint32 PROBE_MS = 300;
+static constexpr Uint32 WARMUP_CALLBACKS = 4;      // device start-up is bursty
+static constexpr Uint32 LATE_TOLERANCE = 3;         // per run, before stepping up
+
+static Uint64 lateThreshold = 0;                    // performance-counter ticks
+static std::atomic<Uint64> lastMixCounter{ 0 };
+static std::atomic<Uint32> mixCallbacks{ 0 };
+static std::atomic<Uint32> lateCallbacks{ 0 };
+
+static AudioLatency latency;
+
+// Audio thread, after every mix
+static void SDLCALL WatchMixTiming(void*, Uint8*, int)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 last = lastMixCounter.exchange(now);
+    if (mixCallbacks.fetch_add(1) >= WARMUP_CALLBACKS && last && now - last > lateThreshold) {
+        lateCallbacks.fetch_add(1);
+    }
+}
+
+static bool OpenDevice(int frequency, Uint16 format, int channels, int chunkSize)
+{
+    if (Mix_OpenAudio(frequency, format, channels, chunkSize) < 0) {
+        std::cout << "Mix_OpenAudio error: " << Mix_GetError() << "\n";
+        return false;
+    }
+
+    int obtained = frequency;
+    Mix_QuerySpec(&obtained, nullptr, nullptr);
+    lateThreshold = (Uint64)(2.0 * chunkSize / obtained * SDL_GetPerformanceFrequency());
+    lastMixCounter.store(0);
+    mixCallbacks.store(0);
+    lateCallbacks.store(0);
+    Mix_SetPostMix(WatchMixTiming, nullptr);
+
+    latency.chunkSize = chunkSize;
+    latency.frequency = obtained;
+    latency.bufferMs = 1000.0 * chunkSize / obtained;
+    return true;
+}
+
+static int ProbeChunkSize(int frequency, Uint16 format, int channels)
+{
+    int best = CHUNK_CANDIDATES[0];
+    for (int size : CHUNK_CANDIDATES)
+    {
+        if (!OpenDevice(frequency, format, channels, size)) break;
+        SDL_Delay(PROBE_MS);
+        Uint32 calls = mixCallbacks.load();
+        Uint32 late = lateCallbacks.load();
+        Mix_SetPostMix(nullptr, nullptr);
+        Mix_CloseAudio();
+
+        std::cout << "[Audio] Probe " << size << " frames: " << calls
+            << " callbacks, " << late << " late\n";
+        if (late > 0 || calls <= WARMUP_CALLBACKS) break;
+        best = size;
+    }
+    return best;
+}
+
+// Remembered size, or 0 if none (or not one we would have picked)
+static int LoadTunedChunkSize()
+{
+    int value = SettingsStore_Get().audio.chunkSize;
+    for (int size : CHUNK_CANDIDATES) {
+        if (size == value) return value;
+    }
+    return 0;
+}
+
+static void SaveTunedChunkSize(int chunkSize)
+{
+    SettingsStore_Get().audio.chunkSize = chunkSize;
+    SettingsStore_MarkDirty(SETTINGS_AUDIO);
+}
+
+// One candidate larger than `chunkSize` (or the largest)
+static int NextLargerChunkSize(int chunkSize)
+{
+    int larger = CHUNK_CANDIDATES[0];
+    for (int size : CHUNK_CANDIDATES) {
+        if (size > chunkSize) larger = size;
+    }
+    return larger;
+}
+
+// ----------------------------------------------------------------------------
+// Timed playback state, one entry per mixer channel. An id is
+// (generation << 8) | channel; `armed` holds the id playing on that channel,
+// with TIMED_FADING set once its fade-out has begun, until the channel goes
+// quiet and the channel-finished callback clears it. Stops (SDL timer thread
+// or a cancel) check and update it under timedStopMutex, so only one fade
+// starts, a halt can still cut that fade short, and a late timer never
+// touches a different sound that reused the channel.
+// ----------------------------------------------------------------------------
+static constexpr int MAX_TIMED_CHANNELS = 256;
+static constexpr Uint32 TIMED_FADING = 0x80000000u;     // above any id
+
+static std::atomic<Uint32> timedArmed[MAX_TIMED_CHANNELS];
+static std::atomic<Uint32> timedFadeMs[MAX_TIMED_CHANNELS];
+static SDL_TimerID timedTimers[MAX_TIMED_CHANNELS];     // UI thread only
+static Uint32 timedGeneration = 0;
+static std::mutex timedStopMutex;       // never taken on the audio thread
+
+// Audio thread: a channel stopped (halted, faded out, or stolen)
+static void OnChannelFinished(int ch)
+{
+    if (ch >= 0 && ch < MAX_TIMED_CHANNELS) {
+        timedArmed[ch].store(0);
+    }
+}
+
+// Fades out or halts `ch` if `id` is still playing on it. A second fade is
+// refused; a halt also ends a fade in progress.
+static bool StopTimed(AudioPlayId id, Uint32 fadeOutMs)
+{
+    if (id == 0) return false;
+    int ch = (int)(id & 0xFF);
+
+    std::lock_guard<std::mutex> lock(timedStopMutex);
+
+    Uint32 state = timedArmed[ch].load();
+    if ((state & ~TIMED_FADING) != id) return false;
+
+    // CAS, not store: the channel may finish on the audio thread meanwhile
+
+    if (fadeOutMs > 0) {
+        if ((state & TIMED_FADING) ||
+            !timedArmed[ch].compare_exchange_strong(state, id | TIMED_FADING)) {
+            return false;
+        }
+        Mix_FadeOutChannel(ch, (int)fadeOutMs);
+    }
+    else {
+        if (!timedArmed[ch].compare_exchange_strong(state, 0)) return false;
+        Mix_HaltChannel(ch);
+    }
+    return true;
+}
+
+// SDL timer thread (mixer calls lock the audio device themselves)
+static Uint32 SDLCALL TimedStopCallback(Uint32, void* param)
+{
+    AudioPlayId id = (AudioPlayId)(uintptr_t)param;
+    StopTimed(id, timedFadeMs[id & 0xFF].load());
+    return 0;   // one-shot
+}
 
 bool Audio_Init(int frequency,
     Uint16 format,
@@ -15,17 +258,54 @@ bool Audio_Init(int frequency,
 
     // Optional: Mix_Init if you use MP3/OGG/FLAC; omitted for brevity. [web:24][web:40]
 
-    if (Mix_OpenAudio(frequency, format, channels, chunkSize) < 0) {
-        std::cout << "Mix_OpenAudio error: " << Mix_GetError() << "\n";
+    // Low-latency mode: the remembered size, or probe for one
+    if (chunkSize <= 0) {
+        chunkSize = LoadTunedChunkSize();
+        if (chunkSize == 0) {
+            chunkSize = ProbeChunkSize(frequency, format, channels);
+            SaveTunedChunkSize(chunkSize);
+        }
+        latency.tuned = true;
+    }
+
+    if (!OpenDevice(frequency, format, channels, chunkSize)) {
         return false;
     }
 
+    // Queued buffer plus the one being played
+    std::streamsize oldPrecision = std::cout.precision();
+    std::cout << "[Audio] Buffer " << chunkSize << " frames = " << std::fixed
+        << std::setprecision(1) << latency.bufferMs << " ms, ~" << 2.0 * latency.bufferMs
+        << " ms output latency\n";
+    std::cout << std::defaultfloat << std::setprecision(oldPrecision);
+
     Mix_AllocateChannels(numSfxChannels); // allow multiple simultaneous SFX [web:25][web:41]
+    Mix_ChannelFinished(OnChannelFinished);
+    Ambient_Init();
+    InstallGainStage();
     return true;
 }
 
 void Audio_Shutdown()
 {
+    for (int ch = 0; ch < MAX_TIMED_CHANNELS; ++ch) {
+        if (timedTimers[ch]) SDL_RemoveTimer(timedTimers[ch]);
+        timedTimers[ch] = 0;
+        timedArmed[ch].store(0);
+    }
+    Mix_ChannelFinished(nullptr);
+    Ambient_Shutdown();
+
+    Mix_UnregisterEffect(MIX_CHANNEL_POST, GainEffect);
+    Mix_SetPostMix(nullptr, nullptr);
+    Uint32 late = lateCallbacks.load();
+    if (latency.tuned && late > LATE_TOLERANCE && latency.chunkSize < CHUNK_CANDIDATES[0]) {
+        int next = NextLargerChunkSize(latency.chunkSize);
+        std::cout << "[Audio] " << late << " late callbacks at " << latency.chunkSize
+            << " frames, using " << next << " next run\n";
+        SaveTunedChunkSize(next);
+    }
+
     Mix_CloseAudio(); // closes audio device [web:17][web:19]
     SDL_QuitSubSystem(SDL_INIT_AUDIO | SDL_INIT_TIMER);
     // If you used SDL_Init only for audio, you can call SDL_Quit() instead. [web:17][web:19]
@@ -37,17 +317,67 @@ Mix_Chunk* Audio_LoadSfx(const std::string& path)
     if (!c) {
         std::cout << "Mix_LoadWAV error (" << path << "): "
             << Mix_GetError() << "\n";
+        return c;
     }
+
+    std::lock_guard<std::mutex> lock(sfxMutex);
+    sfxRegistry.push_back({ path, c });
     return c;
 }
 
 void Audio_FreeSfx(Mix_Chunk* sfx)
 {
     if (sfx) {
+        {
+            std::lock_guard<std::mutex> lock(sfxMutex);
+            std::erase_if(sfxRegistry, [sfx](const SfxInfo& e) { return e.chunk == sfx; });
+        }
         Mix_FreeChunk(sfx); // free sample data [web:17]
     }
 }
 
+AudioLatency Audio_GetLatency()
+{
+    AudioLatency out = latency;
+    out.lateCallbacks = lateCallbacks.load();
+    return out;
+}
+
+void Audio_ReportMemory()
+{
+    size_t resident = 0;
+    size_t decoded = 0;
+
+    std::streamsize oldPrecision = std::cout.precision();
+    std::cout << "[Audio] Resident PCM:\n" << std::fixed << std::setprecision(2);
+
+    {
+        std::lock_guard<std::mutex> lock(sfxMutex);
+        for (const SfxInfo& e : sfxRegistry)
+        {
+            resident += e.chunk->alen;
+            decoded += e.chunk->alen;
+            std::cout << "  " << e.path << ": " << e.chunk->alen / (1024.0 * 1024.0) << " MB\n";
+        }
+    }
+
+    for (const AmbientStreamInfo& e : Ambient_GetStreams())
+    {
+        resident += e.ringBytes;
+        decoded += e.decodedBytes;
+        if (e.procedural) {
+            std::cout << "  " << e.path << ": " << e.ringBytes / 1024.0 << " KB synth state\n";
+            continue;
+        }
+        std::cout << "  " << e.path << ": " << e.ringBytes / (1024.0 * 1024.0)
+            << " MB streamed (decoded " << e.decodedBytes / (1024.0 * 1024.0) << " MB)\n";
+    }
+
+    std::cout << "  total: " << resident / (1024.0 * 1024.0) << " MB"
+        << " (fully decoded " << decoded / (1024.0 * 1024.0) << " MB)\n";
+    std::cout << std::defaultfloat << std::setprecision(oldPrecision);
+}
+
 int Audio_PlayOnce(Mix_Chunk* sfx)
 {
     if (!sfx) return -1;
@@ -100,32 +430,74 @@ void Audio_StopAll()
     Mix_HaltChannel(-1); // -1 = all channels [web:21][web:25]
 }
 
-// Simple blocking timed playback; for real engine, integrate with your own timing.
-int Audio_PlayTimedMs(Mix_Chunk* sfx, Uint32 ms)
+// Non-blocking timed playback: the stop is an SDL timer, not a wait loop
+AudioPlayId Audio_PlayTimedMs(Mix_Chunk* sfx, Uint32 ms, Uint32 fadeOutMs)
 {
-    if (!sfx) return -1;
+    if (!sfx) return 0;
+
+    int ch = Mix_PlayChannel(-1, sfx, -1); // loop; the timer stops it [web:25]
+    if (ch < 0 || ch >= MAX_TIMED_CHANNELS) {
+        if (ch >= 0) Mix_HaltChannel(ch);
+        return 0;
+    }
 
-    int ch = Mix_PlayChannel(-1, sfx, -1); // loop; we will stop it ourselves [web:25]
-    if (ch == -1) return -1;
+    // A previous timed play on this channel is over; drop its timer
+    if (timedTimers[ch]) SDL_RemoveTimer(timedTimers[ch]);
 
-    Uint32 start = SDL_GetTicks();
-    while (SDL_GetTicks() - start < ms) {
-        SDL_Delay(1);
+    timedGeneration = (timedGeneration + 1) & 0x7FFFFF;   // clear of TIMED_FADING
+    if (timedGeneration == 0) timedGeneration = 1;
+    AudioPlayId id = (timedGeneration << 8) | (Uint32)ch;
+
+    fadeOutMs = SDL_min(fadeOutMs, ms);
+    timedFadeMs[ch].store(fadeOutMs);
+    timedArmed[ch].store(id);
+
+    // Fade so the channel is silent at the deadline
+    Uint32 delay = SDL_max(ms - fadeOutMs, 1u);
+    timedTimers[ch] = SDL_AddTimer(delay, TimedStopCallback, (void*)(uintptr_t)id);
+    if (!timedTimers[ch]) {
+        std::cout << "SDL_AddTimer error: " << SDL_GetError() << "\n";
+        StopTimed(id, 0);
+        return 0;
     }
+    return id;
+}
 
-    Mix_HaltChannel(ch); // stop after ms [web:21]
-    return ch;
+bool Audio_CancelTimed(AudioPlayId id, Uint32 fadeOutMs)
+{
+    if (!StopTimed(id, fadeOutMs)) return false;
+
+    int ch = Audio_TimedChannel(id);
+    SDL_RemoveTimer(timedTimers[ch]);
+    timedTimers[ch] = 0;
+    return true;
+}
+
+bool Audio_IsTimedPlaying(AudioPlayId id)
+{
+    return id != 0 && (timedArmed[id & 0xFF].load() & ~TIMED_FADING) == id;
 }
-// Mute all chunks (not music)
+
+int Audio_TimedChannel(AudioPlayId id)
+{
+    return id ? (int)(id & 0xFF) : -1;
+}
+
+// Mute everything (SFX and ambient) through the gain stage, with a short fade
 void Audio_MuteAll()
 {
-    Mix_MasterVolume(0);                // 0 = silence [web:82]
+    muted.store(true);
 }
 
-// Restore all chunks to full volume
+// Back to the volume set with Audio_SetVolume
 void Audio_UnmuteAll()
 {
-    Mix_MasterVolume(MIX_MAX_VOLUME);   // 128 = full volume [web:82][web:64]
+    muted.store(false);
+}
+
+void Audio_SetVolume(float gain)
+{
+    volumeGain.store(std::clamp(gain, 0.0f, 1.0f));
 }
 void Audio_SetChannelVolume(int ch, int vol) // vol 0..MIX_MAX_VOLUME
 {
@@ -133,5 +505,6 @@ void Audio_SetChannelVolume(int ch, int vol) // vol 0..MIX_MAX_VOLUME
 }
 void Audio_SetAllChannelVolume(int vol) // vol: 0 .. MIX_MAX_VOLUME
 {
-    Mix_Volume(-1, vol); // -1 = all channels
+    // Through the smoothed gain stage rather than Mix_Volume's 1/128 steps
+    Audio_SetVolume((float)vol / MIX_MAX_VOLUME);
 }
@@ -4,20 +4,35 @@
 #include <SDL_mixer.h>
 #include <string>
 
-// Call once at program start
+// Call once at program start (after SettingsStore_Load). chunkSize 0 =
+// low-latency mode: the smallest buffer that ran without underruns, probed
+// on first run and remembered in the settings store.
 bool Audio_Init(int frequency = 44100,
     Uint16 format = MIX_DEFAULT_FORMAT,
     int channels = 2,
-    int chunkSize = 2048,
+    int chunkSize = 0,
     int numSfxChannels = 16);
 
-// Call once at program exit
+struct AudioLatency {
+    int chunkSize = 0;          // frames per mixer callback
+    int frequency = 0;
+    double bufferMs = 0.0;      // one buffer; output latency is about twice this
+    bool tuned = false;         // chosen by the low-latency probe
+    Uint32 lateCallbacks = 0;   // suspected underruns since the device opened
+};
+AudioLatency Audio_GetLatency();
+
+// Call once at program exit (before SettingsStore_Shutdown)
 void Audio_Shutdown();
 
-// Load / free sound effect
+// Load / free sound effect (fully decoded; long ambient loops should be
+// streamed with Ambient_Open instead)
 Mix_Chunk* Audio_LoadSfx(const std::string& path);
 void Audio_FreeSfx(Mix_Chunk* sfx);
 
+// Print resident PCM per loaded sound and per ambient stream
+void Audio_ReportMemory();
+
 // Basic playback
 int Audio_PlayOnce(Mix_Chunk* sfx);          // returns channel
 int Audio_PlayLoop(Mix_Chunk* sfx);          // returns channel, loops forever
@@ -36,6 +51,23 @@ void Audio_UnmuteAll();
 void Audio_SetChannelVolume(int ch, int vol);
 void Audio_SetAllChannelVolume(int vol);
 
+// Output volume 0..1 for everything (SFX and ambient). Only stores a target;
+// the audio callback ramps to it smoothly, so it is fine to call every frame.
+void Audio_SetVolume(float gain);
+
+
+// Timed playback (non-blocking). Loops `sfx` and returns at once; an SDL
+// timer stops it `ms` later. With fadeOutMs > 0 the fade starts early enough
+// to reach silence at the deadline. Returns 0 if nothing could be played.
+using AudioPlayId = Uint32;
+AudioPlayId Audio_PlayTimedMs(Mix_Chunk* sfx, Uint32 ms, Uint32 fadeOutMs = 0);
+
+// Stop a timed playback before its deadline (optionally fading out). While
+// a fade-out is running, fadeOutMs = 0 cuts it short; another fade does not.
+// Returns false if it already ended, was stopped some other way, or (for a
+// fade) is already fading out.
+bool Audio_CancelTimed(AudioPlayId id, Uint32 fadeOutMs = 0);
 
-// Timed playback (simple, blocking helper)
-int Audio_PlayTimedMs(Mix_Chunk* sfx, Uint32 ms); // plays, waits, stops
+// True until the channel goes quiet, including its final fade-out
+bool Audio_IsTimedPlaying(AudioPlayId id);
+int Audio_TimedChannel(AudioPlayId id);
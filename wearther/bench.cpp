@@ -0,0 +1,370 @@
+// ============================================================================
+// Benchmarks
+// ============================================================================
+// Each benchmark runs a fixed workload several times and prints min / median
+// / p95 so two builds can be compared. Inputs come from the same recorded
+// data the replay provider serves, so runs are repeatable offline.
+
+#include "bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "json.hpp"
+
+#include "forecast.h"
+#include "noiseSynth.h"
+#include "replayServer.h"
+#include "timerWheel.h"
+#include "weatherFetch.h"
+#include "weatherProvider.h"
+
+using json = nlohmann::json;
+using BenchClock = std::chrono::steady_clock;
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static double ElapsedUs(BenchClock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(BenchClock::now() - start).count();
+}
+
+// ----------------------------------------------------------------------------
+// "<label>: min / median / p95 <unit>" over the samples (sorts them)
+// ----------------------------------------------------------------------------
+static void Report(const char* label, std::vector<double>& samples, const char* unit)
+{
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+
+    double p50 = samples[samples.size() / 2];
+    double p95 = samples[std::min(samples.size() - 1, samples.size() * 95 / 100)];
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "[Bench] %-28s min %9.1f  p50 %9.1f  p95 %9.1f %s (n=%zu)",
+        label, samples.front(), p50, p95, unit, samples.size());
+    std::cout << line << "\n";
+}
+
+static const char* ReplayDirectory()
+{
+    const char* dir = SDL_getenv("WEARTHER_REPLAY_DIR");
+    return dir ? dir : "replay";
+}
+
+// ============================================================================
+// PARSE: SAX handler vs nlohmann DOM
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// The pre-SAX approach: build the whole DOM, then copy the same fields out
+// ----------------------------------------------------------------------------
+static bool DomParse(const std::string& body, CurrentConditions& current, HourlyForecast& hourly)
+{
+    json doc = json::parse(body, nullptr, false);
+    if (doc.is_discarded() || !doc.contains("current_weather")) return false;
+
+    const json& cw = doc["current_weather"];
+    current.temp = cw.value("temperature", 0.0);
+    current.wind = cw.value("windspeed", 0.0);
+    current.code = cw.value("weathercode", -1);
+    current.time = Forecast_IsoMinute(cw.value("time", ""));
+    current.valid = true;
+
+    hourly.Clear();
+    if (!doc.contains("hourly")) return true;
+
+    auto floats = [](const json& arr, std::vector<float>& out) {
+        for (const json& v : arr) out.push_back(v.is_number() ? v.get<float>() : NAN);
+    };
+
+    const json& h = doc["hourly"];
+    for (const json& t : h.value("time", json::array())) {
+        hourly.time.push_back(Forecast_IsoMinute(t.get<std::string>()));
+    }
+    floats(h.value("temperature_2m", json::array()), hourly.temperature);
+    floats(h.value("wind_speed_10m", json::array()), hourly.wind);
+    floats(h.value("relative_humidity_2m", json::array()), hourly.humidity);
+    for (const json& c : h.value("weathercode", json::array())) {
+        hourly.code.push_back(c.is_number() ? c.get<int>() : -1);
+    }
+    return true;
+}
+
+static int BenchParse()
+{
+    static constexpr int WARMUP = 20;
+    static constexpr int ITERATIONS = 500;
+
+    std::string body = ReplayServer_ForecastBody(ReplayDirectory());
+    std::cout << "[Bench] parse: " << body.size() << " byte forecast from "
+        << ReplayDirectory() << "/forecast.json (built-in sample if missing)\n";
+
+    CurrentConditions saxNow, domNow;
+    HourlyForecast saxHourly, domHourly;
+
+    if (!Forecast_Parse(body, saxNow, saxHourly) || !DomParse(body, domNow, domHourly)) {
+        std::cerr << "[Bench] parse: recorded forecast does not parse\n";
+        return 1;
+    }
+    if (saxHourly.Count() != domHourly.Count() || saxNow.temp != domNow.temp ||
+        saxNow.time != domNow.time) {
+        std::cerr << "[Bench] parse: SAX and DOM results differ\n";
+        return 1;
+    }
+
+    std::vector<double> sax, dom;
+    sax.reserve(ITERATIONS);
+    dom.reserve(ITERATIONS);
+
+    // Interleaved so both see the same cache and clock conditions
+    for (int i = 0; i < WARMUP + ITERATIONS; ++i)
+    {
+        auto start = BenchClock::now();
+        Forecast_Parse(body, saxNow, saxHourly);
+        double saxUs = ElapsedUs(start);
+
+        start = BenchClock::now();
+        DomParse(body, domNow, domHourly);
+        double domUs = ElapsedUs(start);
+
+        if (i >= WARMUP) {
+            sax.push_back(saxUs);
+            dom.push_back(domUs);
+        }
+    }
+
+    std::cout << "[Bench] parse: " << saxHourly.Count() << " hours per response\n";
+    Report("SAX (Forecast_Parse)", sax, "us");
+    Report("DOM (json::parse + copy)", dom, "us");
+    return 0;
+}
+
+// ============================================================================
+// TIMERS: per-tick Timers_Advance cost against the number of active timers
+// ============================================================================
+// N repeating timers with deadlines and periods spread over 1 ms .. 10 min,
+// advanced one millisecond at a time on a simulated clock. Every tick pays
+// for what fires and cascades, so the per-tick cost should track the firing
+// rate, not N.
+
+static int BenchTimers()
+{
+    static constexpr int TICKS = 20000;
+    static constexpr int64_t SPREAD_MS = 10 * 60 * 1000;
+    static const int counts[] = { 100, 1000, 10000, 100000 };
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int64_t> spread(1, SPREAD_MS);
+
+    // Simulated clock, carried across rounds so the wheel only moves forward
+    TimerClock::time_point now = TimerClock::now();
+    uint64_t fired = 0;
+
+    std::cout << "[Bench] timers: " << TICKS << " ticks of 1 ms per timer count\n";
+
+    for (int count : counts)
+    {
+        std::vector<TimerId> ids;
+        ids.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            ids.push_back(Timers_AddAt("bench", now + std::chrono::milliseconds(spread(rng)),
+                [&fired](TimerId) { fired++; },
+                std::chrono::milliseconds(spread(rng))));
+        }
+
+        TimerWheelStats before = Timers_GetStats();
+        fired = 0;
+
+        std::vector<double> tickNs;
+        tickNs.reserve(TICKS);
+        for (int t = 0; t < TICKS; ++t)
+        {
+            now += std::chrono::milliseconds(1);
+            auto start = BenchClock::now();
+            Timers_Advance(now);
+            tickNs.push_back(ElapsedUs(start) * 1000.0);
+        }
+
+        TimerWheelStats after = Timers_GetStats();
+        for (TimerId id : ids) Timers_Cancel(id);
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "Advance, %d timers", count);
+        std::cout << "[Bench] timers: " << count << " active, " << fired << " fired, "
+            << (after.cascaded - before.cascaded) << " cascaded\n";
+        Report(label, tickNs, "ns");
+    }
+    return 0;
+}
+
+// ============================================================================
+// SYNTH: CPU cost of the procedural ambient presets
+// ============================================================================
+// Each sample renders two seconds offline, far too slow to pay on the GL
+// thread at every launch.
+
+static int BenchSynth()
+{
+    static constexpr int FREQUENCY = 48000;
+    static constexpr int RUNS = 10;
+    static const SynthKind kinds[] = { SYNTH_RAIN, SYNTH_SURF, SYNTH_WIND };
+
+    std::cout << "[Bench] synth: " << RUNS << " x 2 s rendered offline at "
+        << FREQUENCY << " Hz, stereo\n";
+
+    for (SynthKind kind : kinds)
+    {
+        std::vector<double> cost;
+        for (int i = 0; i < RUNS; ++i) {
+            cost.push_back(Synth_Benchmark(kind, FREQUENCY));
+        }
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "%s, per second of audio", Synth_Name(kind));
+        Report(label, cost, "us");
+    }
+    return 0;
+}
+
+// ============================================================================
+// REFRESH: replay refreshes under a forced-render main loop
+// ============================================================================
+// The idle main loop renders nothing while a refresh runs in the background,
+// so the profiler's busy/idle split sees almost no busy frames. Here every
+// frame is drawn, the worker refreshes back to back against the replay
+// provider (WEARTHER_REPLAY_* configure latency and failures), and each
+// frame records whether a refresh overlapped it.
+
+static constexpr int REFRESH_RUNS = 50;
+static constexpr double REFRESH_INTERVAL_SECONDS = 0.25;
+static constexpr double REFRESH_TIMEOUT_SECONDS = 120.0;
+static const char* REFRESH_CSV = "bench_refresh_frames.csv";
+
+struct BenchFrame
+{
+    double atMs;            // since the benchmark started
+    double frameMs;         // since the previous frame (work + swap)
+    bool refreshing;
+};
+
+static std::vector<BenchFrame> benchFrames;
+static std::vector<double> refreshLatencyMs;
+static int refreshesSeen = 0;
+static int refreshFailures = 0;
+static BenchClock::time_point uiStart;
+static BenchClock::time_point lastFrame;
+
+static bool WriteFrameCsv(const char* path)
+{
+    FILE* f = nullptr;
+    if (fopen_s(&f, path, "w") != 0 || !f) {
+        std::cerr << "[Bench] Failed to open " << path << "\n";
+        return false;
+    }
+
+    std::fprintf(f, "frame,at_ms,frame_ms,refreshing\n");
+    for (size_t i = 0; i < benchFrames.size(); ++i) {
+        const BenchFrame& fr = benchFrames[i];
+        std::fprintf(f, "%zu,%.3f,%.4f,%d\n", i, fr.atMs, fr.frameMs, fr.refreshing ? 1 : 0);
+    }
+
+    std::fclose(f);
+    return true;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+const char* Bench_FromArgs(int argc, char** argv)
+{
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench") == 0) return argv[i + 1];
+    }
+    return nullptr;
+}
+
+int Bench_RunHeadless(const char* name)
+{
+    if (std::strcmp(name, "parse") == 0) return BenchParse();
+    if (std::strcmp(name, "timers") == 0) return BenchTimers();
+    if (std::strcmp(name, "synth") == 0) return BenchSynth();
+    return -1;
+}
+
+bool Bench_IsUi(const char* name)
+{
+    return std::strcmp(name, "refresh") == 0;
+}
+
+void Bench_UiStart(const char*)
+{
+    benchFrames.clear();
+    benchFrames.reserve(1 << 14);
+    refreshLatencyMs.clear();
+    refreshesSeen = 0;
+    refreshFailures = 0;
+
+    std::cout << "[Bench] refresh: " << REFRESH_RUNS << " replay refreshes, "
+        << REFRESH_INTERVAL_SECONDS << " s apart, rendering every frame\n";
+
+    WeatherFetch_StartWith(WeatherProvider_CreateReplay(), REFRESH_INTERVAL_SECONDS);
+
+    uiStart = lastFrame = BenchClock::now();
+}
+
+bool Bench_UiFrame(bool refreshing)
+{
+    auto now = BenchClock::now();
+    benchFrames.push_back({
+        std::chrono::duration<double, std::milli>(now - uiStart).count(),
+        std::chrono::duration<double, std::milli>(now - lastFrame).count(),
+        refreshing });
+    lastFrame = now;
+
+    // Refreshes are REFRESH_INTERVAL_SECONDS apart, so at most one finishes
+    // per frame and lastMs belongs to it
+    WeatherFetchStats stats = WeatherFetch_GetStats();
+    if (stats.refreshes > refreshesSeen) {
+        refreshesSeen = stats.refreshes;
+        refreshFailures = stats.failures;
+        refreshLatencyMs.push_back(stats.lastMs);
+    }
+
+    if (refreshesSeen >= REFRESH_RUNS) return false;
+    if (std::chrono::duration<double>(now - uiStart).count() > REFRESH_TIMEOUT_SECONDS) {
+        std::cerr << "[Bench] refresh: timed out after " << refreshesSeen << " refreshes\n";
+        return false;
+    }
+    return true;
+}
+
+int Bench_UiFinish()
+{
+    std::vector<double> busy, idle;
+    for (const BenchFrame& fr : benchFrames) {
+        (fr.refreshing ? busy : idle).push_back(fr.frameMs);
+    }
+
+    std::cout << "[Bench] refresh: " << refreshesSeen << " refreshes (" << refreshFailures
+        << " failed), " << benchFrames.size() << " frames\n";
+    Report("refresh end-to-end", refreshLatencyMs, "ms");
+    Report("frame, refresh in flight", busy, "ms");
+    Report("frame, no refresh", idle, "ms");
+
+    if (WriteFrameCsv(REFRESH_CSV)) {
+        std::cout << "[Bench] refresh: frame series written to " << REFRESH_CSV << "\n";
+    }
+    return refreshesSeen >= REFRESH_RUNS ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// Opt-in benchmarks, selected on the command line and never run otherwise:
+//
+//   wearther --bench parse     SAX vs DOM parse of the recorded forecast
+//   wearther --bench synth     CPU per second of audio for each ambient preset
+//   wearther --bench timers    Timers_Advance per-tick cost with 100 .. 100K
+//                              active timers
+//   wearther --bench refresh   replay-provider refreshes while every frame
+//                              is rendered (latency + frame-time series)
+//
+// Results go to stdout with a "[Bench]" tag.
+
+// The name after --bench, or nullptr when no benchmark was asked for
+const char* Bench_FromArgs(int argc, char** argv);
+
+// Run a benchmark that needs no window. Returns the process exit code, or
+// -1 if `name` is not a headless benchmark.
+int Bench_RunHeadless(const char* name);
+
+// Benchmarks that need the real main loop (window, GL, fetch worker)
+bool Bench_IsUi(const char* name);
+
+// Starts the fetch worker the way the benchmark needs it; called instead of
+// WeatherFetch_Start
+void Bench_UiStart(const char* name);
+
+// Once per frame, after the swap. While a UI benchmark runs the main loop
+// must render every frame instead of idling. `refreshing` = a refresh was in
+// flight at some point during the frame. Returns false once it is done.
+bool Bench_UiFrame(bool refreshing);
+
+// Print the results and write the frame series; returns the exit code
+int Bench_UiFinish();
@@ -0,0 +1,47 @@
+// ============================================================================
+// Cached Labels
+// ============================================================================
+
+#include "cachedLabel.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+uint64_t Label_Key(int64_t a, int64_t b, int64_t c, int64_t d)
+{
+    // FNV-1a over the four values
+    uint64_t h = 1469598103934665603ull;
+    const int64_t values[4] = { a, b, c, d };
+    const unsigned char* p = (const unsigned char*)values;
+    for (size_t i = 0; i < sizeof(values); ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+const CachedLabel& Label_Update(CachedLabel& label, uint64_t key, const char* fmt, ...)
+{
+    bool changed = !label.formatted || label.key != key;
+    if (changed)
+    {
+        va_list args;
+        va_start(args, fmt);
+        std::vsnprintf(label.text, sizeof(label.text), fmt, args);
+        va_end(args);
+
+        label.key = key;
+        label.formatted = true;
+    }
+
+    ImFont* font = ImGui::GetFont();
+    float fontSize = ImGui::GetFontSize();
+    if (changed || font != label.measuredFont || fontSize != label.measuredFontSize)
+    {
+        label.size = ImGui::CalcTextSize(label.text);
+        label.measuredFont = font;
+        label.measuredFontSize = fontSize;
+    }
+
+    return label;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+#include "imgui.h"
+
+// A formatted label plus its measured size. The text is only re-formatted
+// when the caller's key changes, and only re-measured when the text, font or
+// font size changes, so a label that shows the same value every frame costs
+// no formatting, no CalcTextSize and no heap allocation.
+struct CachedLabel
+{
+    char text[128] = {};
+    ImVec2 size = { 0.0f, 0.0f };
+
+    uint64_t key = 0;
+    bool formatted = false;
+    ImFont* measuredFont = nullptr;
+    float measuredFontSize = 0.0f;
+};
+
+// Pack up to four values into a key (e.g. a temperature in tenths of a degree)
+uint64_t Label_Key(int64_t a, int64_t b = 0, int64_t c = 0, int64_t d = 0);
+
+// Format into the label if `key` differs from the last call, then make sure
+// `size` matches the current font and font size (call with them pushed).
+const CachedLabel& Label_Update(CachedLabel& label, uint64_t key, const char* fmt, ...) IM_FMTARGS(3);
@@ -0,0 +1,64 @@
+// ============================================================================
+// Deadline Timer
+// ============================================================================
+
+#include "deadlineTimer.h"
+
+using Clock = DeadlineTimer::Clock;
+
+void Timer_Set(DeadlineTimer& t, std::chrono::seconds length)
+{
+    t.running = false;
+    t.remaining = length;
+}
+
+void Timer_Chain(DeadlineTimer& t, std::chrono::seconds length)
+{
+    if (t.running) {
+        t.deadline += length;
+    }
+    else {
+        t.remaining = length;
+    }
+}
+
+void Timer_Resume(DeadlineTimer& t, Clock::time_point now)
+{
+    if (t.running) return;
+    t.deadline = now + t.remaining;
+    t.running = true;
+}
+
+void Timer_Pause(DeadlineTimer& t, Clock::time_point now)
+{
+    if (!t.running) return;
+    t.remaining = Timer_Remaining(t, now);
+    t.running = false;
+}
+
+Clock::duration Timer_Remaining(const DeadlineTimer& t, Clock::time_point now)
+{
+    if (!t.running) return t.remaining;
+    return t.deadline > now ? t.deadline - now : Clock::duration::zero();
+}
+
+int Timer_DisplaySeconds(const DeadlineTimer& t, Clock::time_point now)
+{
+    return (int)std::chrono::ceil<std::chrono::seconds>(Timer_Remaining(t, now)).count();
+}
+
+bool Timer_Expired(const DeadlineTimer& t, Clock::time_point now)
+{
+    return Timer_Remaining(t, now) == Clock::duration::zero();
+}
+
+Clock::time_point Timer_NextChange(const DeadlineTimer& t, Clock::time_point now)
+{
+    if (!t.running) return Clock::time_point::max();
+    if (now >= t.deadline) return now;
+
+    // Display shows ceil(remaining); it drops by one when remaining crosses
+    // the next whole second below it
+    int shown = Timer_DisplaySeconds(t, now);
+    return t.deadline - std::chrono::seconds(shown - 1);
+}
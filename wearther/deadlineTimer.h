@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+// Countdown measured against an absolute steady_clock deadline. Remaining
+// time is always derived from "deadline - now", so it does not depend on how
+// often (or whether) frames are drawn and never accumulates per-tick error.
+struct DeadlineTimer
+{
+    using Clock = std::chrono::steady_clock;
+
+    Clock::duration remaining{};    // authoritative while paused
+    Clock::time_point deadline{};   // authoritative while running
+    bool running = false;
+};
+
+// Load a fresh countdown of `length`, paused
+void Timer_Set(DeadlineTimer& t, std::chrono::seconds length);
+
+// Start the next countdown of `length` right where the previous one ended:
+// while running the new deadline is the old deadline + length, so the time
+// between expiry and this call is not lost
+void Timer_Chain(DeadlineTimer& t, std::chrono::seconds length);
+
+void Timer_Resume(DeadlineTimer& t, DeadlineTimer::Clock::time_point now);
+void Timer_Pause(DeadlineTimer& t, DeadlineTimer::Clock::time_point now);
+
+// Time left (never negative)
+DeadlineTimer::Clock::duration Timer_Remaining(const DeadlineTimer& t, DeadlineTimer::Clock::time_point now);
+
+// Whole seconds to display, rounded up: a fresh 25:00 stays 25:00 for its
+// first second and 00:00 is only reached at the deadline
+int Timer_DisplaySeconds(const DeadlineTimer& t, DeadlineTimer::Clock::time_point now);
+
+bool Timer_Expired(const DeadlineTimer& t, DeadlineTimer::Clock::time_point now);
+
+// When Timer_DisplaySeconds next changes (time_point::max() while paused)
+DeadlineTimer::Clock::time_point Timer_NextChange(const DeadlineTimer& t, DeadlineTimer::Clock::time_point now);
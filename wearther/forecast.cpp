@@ -0,0 +1,245 @@
+// ============================================================================
+// Open-Meteo Forecast Parser
+// ============================================================================
+// The forecast response is several kilobytes of hourly arrays. Building a
+// full nlohmann::json DOM for it allocates a node per number; this SAX handler
+// instead walks the token stream once and writes the few fields we use
+// straight into the preallocated HourlyForecast arrays.
+
+#include "forecast.h"
+#include "json.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using json = nlohmann::json;
+
+// A week of hourly data is the Open-Meteo default
+static constexpr size_t DEFAULT_HOURS = 7 * 24;
+
+void HourlyForecast::Clear()
+{
+    time.clear();
+    temperature.clear();
+    wind.clear();
+    humidity.clear();
+    code.clear();
+}
+
+void HourlyForecast::Reserve(size_t hours)
+{
+    time.reserve(hours);
+    temperature.reserve(hours);
+    wind.reserve(hours);
+    humidity.reserve(hours);
+    code.reserve(hours);
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant)
+// ----------------------------------------------------------------------------
+static int64_t DaysFromCivil(int y, int m, int d)
+{
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const int64_t yoe = y - era * 400;
+    const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// ============================================================================
+// SAX HANDLER
+// ============================================================================
+
+class ForecastSax
+{
+public:
+    ForecastSax(CurrentConditions& current, HourlyForecast& hourly)
+        : current(current), hourly(hourly) {}
+
+    // --- scalars ---
+    bool null()                                        { Value(NAN); return true; }
+    bool boolean(bool)                                 { return true; }
+    bool number_integer(json::number_integer_t v)      { Value((double)v); return true; }
+    bool number_unsigned(json::number_unsigned_t v)    { Value((double)v); return true; }
+    bool number_float(json::number_float_t v, const json::string_t&) { Value(v); return true; }
+    bool binary(json::binary_t&)                       { return true; }
+
+    bool string(json::string_t& v)
+    {
+        if (section == Section::Hourly && field == Field::Time && depth == 3) {
+            hourly.time.push_back(Forecast_IsoMinute(v));
+        }
+        else if (section == Section::Current && field == Field::Time && depth == 2) {
+            current.time = Forecast_IsoMinute(v);
+        }
+        return true;
+    }
+
+    // --- structure ---
+    bool start_object(std::size_t) { ++depth; return true; }
+    bool start_array(std::size_t)  { ++depth; return true; }
+
+    bool end_object()
+    {
+        if (depth == 2) section = Section::None;
+        --depth;
+        return true;
+    }
+
+    bool end_array()
+    {
+        if (depth == 3) field = Field::None;
+        --depth;
+        return true;
+    }
+
+    bool key(json::string_t& k)
+    {
+        if (depth == 1) {
+            if (k == "current_weather") section = Section::Current;
+            else if (k == "hourly") section = Section::Hourly;
+            else section = Section::None;
+        }
+        else if (depth == 2) {
+            field = FieldFor(k);
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const json::exception&)
+    {
+        return false;
+    }
+
+private:
+    enum class Section { None, Current, Hourly };
+    enum class Field { None, Time, Temperature, Wind, Humidity, Code };
+
+    Field FieldFor(const std::string& k) const
+    {
+        if (section == Section::Current) {
+            if (k == "time") return Field::Time;
+            if (k == "temperature") return Field::Temperature;
+            if (k == "windspeed") return Field::Wind;
+            if (k == "weathercode") return Field::Code;
+        }
+        else if (section == Section::Hourly) {
+            if (k == "time") return Field::Time;
+            if (k == "temperature_2m") return Field::Temperature;
+            if (k == "wind_speed_10m") return Field::Wind;
+            if (k == "relative_humidity_2m") return Field::Humidity;
+            if (k == "weathercode") return Field::Code;
+        }
+        return Field::None;
+    }
+
+    void Value(double v)
+    {
+        if (section == Section::Current && depth == 2)
+        {
+            current.valid = true;
+            switch (field) {
+            case Field::Temperature: current.temp = std::isnan(v) ? 0.0 : v; break;
+            case Field::Wind:        current.wind = std::isnan(v) ? 0.0 : v; break;
+            case Field::Code:        current.code = std::isnan(v) ? -1 : (int)v; break;
+            default: break;
+            }
+        }
+        else if (section == Section::Hourly && depth == 3)
+        {
+            switch (field) {
+            case Field::Temperature: hourly.temperature.push_back((float)v); break;
+            case Field::Wind:        hourly.wind.push_back((float)v); break;
+            case Field::Humidity:    hourly.humidity.push_back((float)v); break;
+            case Field::Code:        hourly.code.push_back(std::isnan(v) ? -1 : (int)v); break;
+            default: break;
+            }
+        }
+    }
+
+    CurrentConditions& current;
+    HourlyForecast& hourly;
+
+    int depth = 0;
+    Section section = Section::None;
+    Field field = Field::None;
+};
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+int64_t Forecast_IsoMinute(const std::string& s)
+{
+    int y = 0, mo = 0, d = 0, h = 0, mi = 0;
+    if (std::sscanf(s.c_str(), "%d-%d-%dT%d:%d", &y, &mo, &d, &h, &mi) != 5) {
+        return 0;
+    }
+    return DaysFromCivil(y, mo, d) * 86400 + h * 3600 + mi * 60;
+}
+
+bool Forecast_Parse(const std::string& body, CurrentConditions& current, HourlyForecast& hourly)
+{
+    current = CurrentConditions{};
+    hourly.Clear();
+    if (hourly.time.capacity() == 0) {
+        hourly.Reserve(DEFAULT_HOURS);
+    }
+
+    ForecastSax handler(current, hourly);
+    if (!json::sax_parse(body, &handler)) {
+        hourly.Clear();
+        return false;
+    }
+
+    // Every series must line up with the timestamps; pad short ones
+    size_t n = hourly.time.size();
+    hourly.temperature.resize(n, NAN);
+    hourly.wind.resize(n, NAN);
+    hourly.humidity.resize(n, NAN);
+    hourly.code.resize(n, -1);
+
+    return current.valid;
+}
+
+void Forecast_BuildStrip(const HourlyForecast& hourly, int64_t now, ForecastStrip& strip)
+{
+    strip = ForecastStrip{};
+
+    // First sample of the current hour
+    int64_t hourStart = now - now % 3600;
+    size_t first = 0;
+    while (first < hourly.Count() && hourly.time[first] < hourStart) {
+        ++first;
+    }
+
+    for (size_t i = first; i < hourly.Count() && strip.count < ForecastStrip::MAX_SLOTS; ++i)
+    {
+        int slot = strip.count++;
+        float temp = hourly.temperature[i];
+        int64_t secondsOfDay = ((hourly.time[i] % 86400) + 86400) % 86400;
+
+        std::snprintf(strip.hourLabel[slot], sizeof(strip.hourLabel[slot]), "%02d:00",
+            (int)(secondsOfDay / 3600));
+        if (std::isnan(temp)) {
+            std::snprintf(strip.tempLabel[slot], sizeof(strip.tempLabel[slot]), "--");
+        }
+        else {
+            std::snprintf(strip.tempLabel[slot], sizeof(strip.tempLabel[slot]), "%.0f\xC2\xB0", temp);
+        }
+
+        strip.temperature[slot] = temp;
+        strip.code[slot] = hourly.code[i];
+
+        if (!std::isnan(temp)) {
+            if (slot == 0 || temp < strip.minTemp) strip.minTemp = temp;
+            if (slot == 0 || temp > strip.maxTemp) strip.maxTemp = temp;
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Current conditions from the Open-Meteo "current_weather" block
+struct CurrentConditions
+{
+    int64_t time = 0;       // local seconds since 1970, like HourlyForecast::time
+    double temp = 0.0;
+    double wind = 0.0;
+    int code = -1;
+    bool valid = false;
+};
+
+// Hourly series from the "hourly" block, one contiguous array per variable.
+// Timestamps are seconds since 1970 in the forecast's own (local) timezone.
+// Missing samples are NaN (or -1 for the weather code).
+struct HourlyForecast
+{
+    std::vector<int64_t> time;
+    std::vector<float> temperature;
+    std::vector<float> wind;
+    std::vector<float> humidity;
+    std::vector<int> code;
+
+    size_t Count() const { return time.size(); }
+
+    // Empty every series but keep the capacity for the next parse
+    void Clear();
+    void Reserve(size_t hours);
+};
+
+// Display-ready slice of the next hours for the forecast strip. Built once
+// per fetch so drawing it needs no formatting or allocation.
+struct ForecastStrip
+{
+    static constexpr int MAX_SLOTS = 12;
+
+    int count = 0;
+    char hourLabel[MAX_SLOTS][8] = {};      // "13:00"
+    char tempLabel[MAX_SLOTS][8] = {};      // "21°"
+    float temperature[MAX_SLOTS] = {};
+    int code[MAX_SLOTS] = {};
+    float minTemp = 0.0f;
+    float maxTemp = 0.0f;
+};
+
+// "2024-05-01T13:00" -> seconds since 1970, no timezone applied (0 if
+// malformed). The conversion every forecast timestamp goes through.
+int64_t Forecast_IsoMinute(const std::string& s);
+
+// Streaming (SAX) extraction of just the fields above; no DOM is built.
+// Arrays are appended into `hourly`, which is cleared first. Returns false
+// on malformed JSON or when "current_weather" is missing.
+bool Forecast_Parse(const std::string& body, CurrentConditions& current, HourlyForecast& hourly);
+
+// Fill `strip` with the hours starting at `now` (same clock as the series)
+void Forecast_BuildStrip(const HourlyForecast& hourly, int64_t now, ForecastStrip& strip);
@@ -1,7 +1,11 @@
 #include "httplib.h"
 #include "json.hpp"
 
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <sstream>
 #include "http.h"
@@ -10,6 +14,82 @@
 
 using json = nlohmann::json;
 
+// Requests run on the fetch worker; keep them bounded so shutdown can join it
+static constexpr time_t CONNECT_TIMEOUT_SEC = 5;
+static constexpr time_t READ_TIMEOUT_SEC = 10;
+
+// --------------------------------------------------------
+// CLIENT POOL (one keep-alive client per host)
+// --------------------------------------------------------
+static std::mutex poolMutex;
+static std::map<std::string, std::unique_ptr<httplib::Client>> pool;
+
+static std::atomic<uint64_t> requestCount{ 0 };
+static std::atomic<uint64_t> connectCount{ 0 };
+static std::atomic<uint64_t> reuseCount{ 0 };
+static std::atomic<uint64_t> failureCount{ 0 };
+
+// Long-lived client for a host; its socket stays open between refreshes.
+// Clients are only used from the fetch worker, one request at a time.
+static httplib::Client& ClientFor(const std::string& host)
+{
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    std::unique_ptr<httplib::Client>& client = pool[host];
+    if (!client)
+    {
+        client = std::make_unique<httplib::Client>(host);
+        client->set_keep_alive(true);
+        client->set_connection_timeout(CONNECT_TIMEOUT_SEC);
+        client->set_read_timeout(READ_TIMEOUT_SEC);
+
+        // Only runs when a new socket is opened, so it counts real connects
+        client->set_socket_options([](socket_t sock) {
+            httplib::default_socket_options(sock);
+            connectCount++;
+        });
+    }
+    return *client;
+}
+
+// GET through the host's pooled client. A request counts as reused only if
+// it got a response without opening a socket; DNS or connect failures are
+// counted as failures, not reuse. (Fetch worker only, so the connect count
+// can't move under us between the two reads.)
+static httplib::Result PooledGet(const std::string& host, const std::string& path)
+{
+    httplib::Client& client = ClientFor(host);
+
+    uint64_t connectsBefore = connectCount.load();
+    requestCount++;
+
+    httplib::Result res = client.Get(path);
+    if (!res) failureCount++;
+    else if (connectCount.load() == connectsBefore) reuseCount++;
+    return res;
+}
+
+HttpStats Http_GetStats()
+{
+    HttpStats stats;
+    stats.requests = requestCount.load();
+    stats.connects = connectCount.load();
+    stats.reused = reuseCount.load();
+    stats.failed = failureCount.load();
+    return stats;
+}
+
+void Http_ClosePool()
+{
+    std::lock_guard<std::mutex> lock(poolMutex);
+    pool.clear();
+
+    HttpStats stats = Http_GetStats();
+    std::cout << "[Http] " << stats.requests << " requests, "
+        << stats.connects << " connects, " << stats.reused << " reused, "
+        << stats.failed << " failed\n";
+}
+
 // --------------------------------------------------------
 // WEATHER STATUS TEXT
 // --------------------------------------------------------
@@ -55,41 +135,19 @@ std::string GetWeatherStatus(int code)
     }
 }
 
-// --------------------------------------------------------
-// GET CITY NAME BY IP
-// --------------------------------------------------------
-std::string GetCity()
-{
-    std::string city = "unknown";
-
-    httplib::Client geo("http://ip-api.com");
-
-    if (auto res = geo.Get("/json"))
-    {
-        if (res->status == 200)
-        {
-            json j = json::parse(res->body);
-            city = j.value("city", "unknown");
-
-            std::cout << "City: " << city << "\n";
-        }
-    }
-
-    return city;
-}
-
 // --------------------------------------------------------
 // WEATHER FETCH FUNCTION
 // --------------------------------------------------------
-climate Getweather(double lat, double lon)
+climate Getweather(const std::string& host, double lat, double lon, HourlyForecast* hourly)
 {
-    double temp = 0.0;
-    double wind = 0.0;
+    climate current{};
+
+    // Reused between calls when the caller does not want the series
+    static HourlyForecast scratch;
+    HourlyForecast& series = hourly ? *hourly : scratch;
 
     if (lat != 0.0 || lon != 0.0)
     {
-        httplib::Client cli("http://api.open-meteo.com");
-
         std::ostringstream url;
         url << "/v1/forecast?"
             << "latitude=" << lat
@@ -98,55 +156,52 @@ climate Getweather(double lat, double lon)
             << "&hourly=temperature_2m,wind_speed_10m,relative_humidity_2m,weathercode"
             << "&timezone=auto";
 
-        if (auto res = cli.Get(url.str().c_str()))
+        if (auto res = PooledGet(host, url.str()))
         {
             if (res->status == 200)
             {
-                json w = json::parse(res->body);
-
-                if (w.contains("current_weather"))
+                CurrentConditions now;
+                if (Forecast_Parse(res->body, now, series))
                 {
-                    temp = w["current_weather"].value("temperature", 0.0);
-                    wind = w["current_weather"].value("windspeed", 0.0);
+                    current.temp = now.temp;
+                    current.wind = now.wind;
+                    current.code = now.code;
+                    current.time = now.time;
+                    current.valid = true;
                 }
             }
         }
-        climate current;
-        current.temp = temp;
-        current.wind = wind;
-        return current;
     }
 
-    // i = 1 ? return temperature
-    // i = anything else ? wind
-    
+    return current;
 }
 
 // --------------------------------------------------------
-// GET LAT/LON VIA IP LOOKUP
+// GEOLOCATION VIA IP LOOKUP (one request for every field)
 // --------------------------------------------------------
-loc1 getpos()
+GeoLocation GetGeoLocation(const std::string& host)
 {
-    double lat1 = 0.0;
-    double lon1 = 0.0;
+    GeoLocation result;
 
-    httplib::Client geo("http://ip-api.com");
-
-    if (auto res = geo.Get("/json"))
+    if (auto res = PooledGet(host, "/json?fields=status,lat,lon,city,timezone"))
     {
         if (res->status == 200)
         {
             json j = json::parse(res->body);
-            lat1 = j.value("lat", 0.0);
-            lon1 = j.value("lon", 0.0);
-
-            std::cout << "Lat: " << lat1 << " Lon: " << lon1 << "\n";
+            if (j.value("status", "") == "success")
+            {
+                result.lat = j.value("lat", 0.0);
+                result.lon = j.value("lon", 0.0);
+                result.city = j.value("city", "unknown");
+                result.timezone = j.value("timezone", "");
+                result.valid = true;
+
+                std::cout << "City: " << result.city
+                    << " Lat: " << result.lat << " Lon: " << result.lon
+                    << " (" << result.timezone << ")\n";
+            }
         }
     }
 
-    loc1 result;
-    result.lat = lat1;
-    result.lon = lon1;
-
     return result;
 }
@@ -1,26 +1,54 @@
 #pragma once
 
 #include<iostream>
+#include <cstdint>
+#include <string>
+
+#include "forecast.h"
 
 
-std::string GetCity();
 struct climate
 {
     double wind;
     double temp;
+    int code = -1;      // WMO weather code, -1 if unknown
+    int64_t time = 0;   // observation time, forecast-local seconds since 1970
+    bool valid = false; // false if the request or the parse failed
 };
 
-climate Getweather( double lat, double lon);
+// Public endpoints; a WeatherProvider may point these calls elsewhere
+inline constexpr const char* OPEN_METEO_HOST = "http://api.open-meteo.com";
+inline constexpr const char* IP_API_HOST = "http://ip-api.com";
+
+// Current conditions from an Open-Meteo compatible host; the hourly series
+// is written into `hourly` if given
+climate Getweather(const std::string& host, double lat, double lon, HourlyForecast* hourly = nullptr);
 std::string GetWeatherStatus(int code);
 
 
 
-struct loc1
+// Everything ip-api.com knows about us, from a single request
+struct GeoLocation
 {
-
-    double lat;
-    double lon;
+    double lat = 0.0;
+    double lon = 0.0;
+    std::string city = "unknown";
+    std::string timezone;
+    bool valid = false;
 };
-loc1 getpos();
+GeoLocation GetGeoLocation(const std::string& host);
 
+// Requests go through one keep-alive client per host. A request is "reused"
+// when it got a response without opening a new socket; "failed" ones got no
+// response at all (DNS, connect or read error).
+struct HttpStats
+{
+    uint64_t requests = 0;
+    uint64_t connects = 0;
+    uint64_t reused = 0;
+    uint64_t failed = 0;
+};
+HttpStats Http_GetStats();
 
+// Close every pooled connection (after the fetch worker has stopped)
+void Http_ClosePool();
@@ -0,0 +1,257 @@
+// ============================================================================
+// Window Layout
+// ============================================================================
+// Every number below is in design units (the 1280x720 canvas the tabs were
+// tuned on) and goes through S() on the way out, so a 2560x1440 window gets
+// the same picture at twice the size. Positions and sizes are snapped to the
+// framebuffer's pixel grid, which keeps text and icon edges crisp when the
+// window is scaled by a fraction.
+
+#include "layout.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "loadTexture.h"
+#include "textureAtlas.h"
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+static AppLayout layout;
+static GLuint logoTexture = 0;
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+// Design units -> window units
+static float S(float v)
+{
+    return v * layout.scale;
+}
+
+static ImVec2 S(const ImVec2& v)
+{
+    return ImVec2(v.x * layout.scale, v.y * layout.scale);
+}
+
+// Round to the nearest framebuffer pixel
+static float Snap(float v)
+{
+    return std::round(v * layout.pixelScale) / layout.pixelScale;
+}
+
+static ImVec2 Snap(const ImVec2& v)
+{
+    return ImVec2(Snap(v.x), Snap(v.y));
+}
+
+// Keep aspect ratio inside maxBox (maxBox itself if the size is unknown)
+static ImVec2 ScaleToFit(const ImVec2& size, const ImVec2& maxBox)
+{
+    if (size.x <= 0 || size.y <= 0) {
+        return maxBox;
+    }
+    float scale = std::min(maxBox.x / size.x, maxBox.y / size.y);
+    return ImVec2(size.x * scale, size.y * scale);
+}
+
+// Button icons are drawn at half their source size (120 if unknown)
+static ImVec2 ButtonImage(UiIcon icon)
+{
+    ImVec2 raw = Atlas_Get(icon).size;
+    if (raw.x <= 0) raw = ImVec2(120, 120);
+    return Snap(S(ImVec2(raw.x * 0.5f, raw.y * 0.5f)));
+}
+
+// ============================================================================
+// PER-TAB LAYOUT
+// ============================================================================
+
+static void LayoutTabs(TabBarLayout& t)
+{
+    const AppLayout& L = layout;
+
+    t.window.pos = Snap(ImVec2(0, S(6)));
+    t.window.size = Snap(ImVec2(L.display.x, S(80)));
+    t.padding = Snap(S(6));
+    t.button = Snap(S(ImVec2(110, 40)));
+    t.spacing = Snap(S(8));
+    t.firstX = Snap((L.display.x - (t.button.x * 3 + t.spacing * 2)) * 0.5f);
+    t.framePadding = Snap(S(ImVec2(18, 12)));
+    t.rounding = S(14);
+    t.fontScale = L.scale;
+}
+
+static void LayoutPomodoro(PomodoroLayout& p)
+{
+    const AppLayout& L = layout;
+
+    // ---- Logo, centered a little above the middle ----
+    ImVec2 logoRaw(0, 0);
+    if (const TextureInfo* info = Texture_GetInfo(logoTexture)) {
+        logoRaw = ImVec2((float)info->srcWidth, (float)info->srcHeight);
+    }
+    p.logo.size = Snap(ScaleToFit(logoRaw, S(ImVec2(500, 500))));
+    p.logo.pos = Snap(ImVec2(
+        (L.display.x - p.logo.size.x) * 0.5f,
+        (L.display.y - p.logo.size.y) * 0.5f - S(90)));
+
+    // ---- Round arrows either side of the logo ----
+    p.arrowImage = Snap(ScaleToFit(Atlas_Get(ICON_ARROW).size, S(ImVec2(150, 150))));
+    p.arrowCursor = Snap(S(ImVec2(5, 5)));
+
+    ImVec2 arrowWindow(p.arrowImage.x + p.arrowCursor.x * 2, p.arrowImage.y + p.arrowCursor.y * 2);
+    float arrowY = p.logo.pos.y + p.logo.size.y * 0.2f;
+
+    p.arrowRight.pos = Snap(ImVec2(p.logo.pos.x + p.logo.size.x + S(50), arrowY));
+    p.arrowRight.size = arrowWindow;
+    p.arrowLeft.pos = Snap(ImVec2(p.logo.pos.x - p.arrowImage.x - S(70), arrowY));
+    p.arrowLeft.size = arrowWindow;
+
+    // ---- Text ----
+    p.statsY = Snap(L.center.y + S(120));
+    p.statsPadding = Snap(S(20));
+    p.statsFontScale = 6.0f * L.scale;
+
+    p.sessionLabelY = Snap(L.center.y - S(150));
+    p.sessionLabelFontScale = 6.5f * L.scale;
+    p.timerFontScale = 8.0f * L.scale;
+
+    // ---- Control bar: stop | start/pause | reset, along the bottom ----
+    p.stop.image = ButtonImage(ICON_RESET);     // icons are swapped on purpose
+    p.start.image = ButtonImage(ICON_START);
+    p.pause.image = ButtonImage(ICON_PAUSE);
+    p.reset.image = ButtonImage(ICON_STOP);
+
+    float padding = Snap(S(6));
+    ImVec2 stopSlot(p.stop.image.x + padding * 2, p.stop.image.y + padding * 2);
+    ImVec2 startSlot(
+        std::max(p.start.image.x, p.pause.image.x) + padding * 2,
+        std::max(p.start.image.y, p.pause.image.y) + padding * 2);
+    ImVec2 resetSlot(p.reset.image.x + padding * 2, p.reset.image.y + padding * 2);
+
+    // Hand-tuned nudges from the original artwork
+    const ImVec2 stopOffset = S(ImVec2(0, 0));
+    const ImVec2 startOffset = S(ImVec2(20, 10));
+    const ImVec2 resetOffset = S(ImVec2(-20, -30));
+    const float buttonSpacing = S(28);
+
+    float baseY = L.display.y - std::max({ stopSlot.y, startSlot.y, resetSlot.y }) - S(30);
+
+    ImVec2 startPos(L.center.x - startSlot.x * 0.5f + startOffset.x, baseY + startOffset.y);
+    ImVec2 stopPos(startPos.x - buttonSpacing - stopSlot.x + stopOffset.x, baseY + stopOffset.y);
+    ImVec2 resetPos(startPos.x + startSlot.x + buttonSpacing + resetOffset.x, baseY + resetOffset.y);
+
+    ImVec2 barMin(stopPos.x, std::min({ stopPos.y, startPos.y, resetPos.y }));
+    ImVec2 barMax(
+        resetPos.x + resetSlot.x,
+        std::max({ stopPos.y + stopSlot.y, startPos.y + startSlot.y, resetPos.y + resetSlot.y }));
+
+    p.controlBar.pos = Snap(barMin);
+    p.controlBar.size = Snap(ImVec2(barMax.x - barMin.x, barMax.y - barMin.y));
+
+    // Each image centered in its slot, relative to the bar
+    auto place = [&](LayoutButton& b, ImVec2 slotPos, ImVec2 slot) {
+        b.cursor = Snap(ImVec2(
+            slotPos.x - barMin.x + (slot.x - b.image.x) * 0.5f,
+            slotPos.y - barMin.y + (slot.y - b.image.y) * 0.5f));
+    };
+    place(p.stop, stopPos, stopSlot);
+    place(p.start, startPos, startSlot);
+    place(p.pause, startPos, startSlot);
+    place(p.reset, resetPos, resetSlot);
+}
+
+static void LayoutWeather(WeatherLayout& w)
+{
+    const AppLayout& L = layout;
+
+    w.icon.size = Snap(S(ImVec2(300, 200)));
+    w.icon.pos = Snap(ImVec2(
+        (L.display.x - w.icon.size.x) * 0.5f,
+        (L.display.y - w.icon.size.y) * 0.5f - S(100)));
+
+    // Text and city sat in windows ImGui auto-placed at (60, 60); they are
+    // full-window now, so that origin is folded in here
+    const float textOrigin = S(60);
+
+    w.textY = Snap(L.center.y + S(30) + textOrigin);
+    w.textFontScale = 6.0f * L.scale;
+
+    w.timePos = Snap(ImVec2(
+        (L.display.x - S(400)) * 0.5f,
+        (L.display.y - S(200)) * 0.5f + S(250)));
+    w.timeFontScale = 6.0f * L.scale;
+
+    w.cityPos = Snap(ImVec2(S(20) + textOrigin, S(1) + textOrigin));
+    w.cityFontScale = 4.0f * L.scale;
+    w.staleFontScale = 2.0f * L.scale;
+
+    w.stripCellWidth = Snap(S(70));
+    w.stripHeight = Snap(S(110));
+    w.stripY = Snap(L.display.y - w.stripHeight - S(20));
+    w.stripRounding = S(12);
+    w.stripTextInset = Snap(S(8));
+    w.stripLineTop = Snap(S(32));
+    w.stripLineBottom = Snap(S(34));
+    w.stripLineWidth = S(2);
+    w.stripPointRadius = S(3);
+    w.stripFontScale = L.scale;
+}
+
+static void LayoutSettings(SettingsLayout& s)
+{
+    const AppLayout& L = layout;
+
+    s.panel.size = Snap(S(ImVec2(640, 360)));
+    s.panel.pos = Snap(ImVec2(L.center.x - s.panel.size.x * 0.5f, L.center.y - s.panel.size.y * 0.5f));
+    s.fontScale = L.scale;
+    s.headingGap = Snap(S(35));
+    s.rowGap = Snap(S(24));
+    s.labelOffsetX = Snap(S(240));
+    s.toggleWidth = Snap(S(50));
+    s.sliderWidth = Snap(S(300));
+    s.controlHeight = Snap(S(26));
+    s.comboWidth = Snap(S(200));
+    s.comboPadding = Snap(S(ImVec2(14, 5)));
+    s.popupRounding = S(8);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+void Layout_Init(GLuint logo)
+{
+    logoTexture = logo;
+}
+
+void Layout_Update(int windowWidth, int windowHeight, int drawableWidth, int drawableHeight)
+{
+    // Minimized: keep the last layout
+    if (windowWidth <= 0 || windowHeight <= 0) return;
+
+    layout.display = ImVec2((float)windowWidth, (float)windowHeight);
+    layout.center = ImVec2(layout.display.x * 0.5f, layout.display.y * 0.5f);
+    layout.scale = std::min(
+        layout.display.x / LAYOUT_DESIGN_WIDTH,
+        layout.display.y / LAYOUT_DESIGN_HEIGHT);
+    // Framebuffer pixels per window unit. Both axes match on every platform
+    // SDL supports; if one ever didn't, snapping to the coarser one is safe.
+    float densityX = drawableWidth > 0 ? (float)drawableWidth / windowWidth : 1.0f;
+    float densityY = drawableHeight > 0 ? (float)drawableHeight / windowHeight : 1.0f;
+    layout.pixelScale = std::min(densityX, densityY);
+    layout.rootFontScale = 6.0f * layout.scale;
+
+    LayoutTabs(layout.tabs);
+    LayoutPomodoro(layout.pomodoro);
+    LayoutWeather(layout.weather);
+    LayoutSettings(layout.settings);
+}
+
+const AppLayout& Layout_Get()
+{
+    return layout;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <glad/glad.h>
+#include "imgui.h"
+
+// Widget rectangles for every tab, computed once per window resize instead
+// of every frame. The tabs were designed on a 1280x720 canvas; everything
+// here is that design scaled to fit the current window and snapped to
+// physical pixels, so the window can be resized or go fullscreen on a 4K
+// display. Only centering against a label's measured width is left to the
+// tabs, since that depends on the text, not on the window.
+
+// Design canvas the offsets below were tuned on
+static constexpr float LAYOUT_DESIGN_WIDTH = 1280.0f;
+static constexpr float LAYOUT_DESIGN_HEIGHT = 720.0f;
+
+struct LayoutRect
+{
+    ImVec2 pos = ImVec2(0, 0);
+    ImVec2 size = ImVec2(0, 0);
+};
+
+// One image button inside the Pomodoro control bar
+struct LayoutButton
+{
+    ImVec2 cursor = ImVec2(0, 0);   // relative to the bar window
+    ImVec2 image = ImVec2(0, 0);
+};
+
+struct TabBarLayout
+{
+    LayoutRect window;
+    float padding = 6.0f;           // window padding (y)
+    float firstX = 0.0f;            // cursor x of the first button
+    float spacing = 8.0f;
+    ImVec2 button = ImVec2(110, 40);
+    ImVec2 framePadding = ImVec2(18, 12);
+    float rounding = 14.0f;
+    float fontScale = 1.0f;
+};
+
+struct PomodoroLayout
+{
+    // Logo screen
+    LayoutRect logo;
+    LayoutRect arrowLeft;
+    LayoutRect arrowRight;
+    ImVec2 arrowCursor = ImVec2(5, 5);
+    ImVec2 arrowImage = ImVec2(0, 0);
+    float statsY = 0.0f;            // top of the stats line
+    float statsPadding = 20.0f;     // added to the stats window size
+    float statsFontScale = 6.0f;
+
+    // Timer screen (label and countdown center on their own width)
+    float sessionLabelY = 0.0f;
+    float sessionLabelFontScale = 6.5f;
+    float timerFontScale = 8.0f;
+
+    // Stop / start-or-pause / reset, in one bar window
+    LayoutRect controlBar;
+    LayoutButton stop;
+    LayoutButton start;
+    LayoutButton pause;             // same slot as start
+    LayoutButton reset;
+};
+
+struct WeatherLayout
+{
+    LayoutRect icon;                // cursor pos + image size
+    float textY = 0.0f;             // temperature / wind, centered on x
+    float textFontScale = 6.0f;
+    ImVec2 timePos = ImVec2(0, 0);
+    float timeFontScale = 6.0f;
+    ImVec2 cityPos = ImVec2(20, 1);
+    float cityFontScale = 4.0f;
+    float staleFontScale = 2.0f;    // "saved forecast" note under the city
+
+    // Hourly strip (width depends on the slot count, centered on x)
+    float stripCellWidth = 70.0f;
+    float stripHeight = 110.0f;
+    float stripY = 0.0f;
+    float stripRounding = 12.0f;
+    float stripTextInset = 8.0f;    // hour labels from the top, temps from the bottom
+    float stripLineTop = 32.0f;     // temperature line band, from the top
+    float stripLineBottom = 34.0f;  // ... and from the bottom
+    float stripLineWidth = 2.0f;
+    float stripPointRadius = 3.0f;
+    float stripFontScale = 1.0f;
+};
+
+struct SettingsLayout
+{
+    LayoutRect panel;
+    float fontScale = 1.0f;
+    float headingGap = 35.0f;
+    float rowGap = 24.0f;
+    float labelOffsetX = 240.0f;
+    float toggleWidth = 50.0f;
+    float sliderWidth = 300.0f;
+    float controlHeight = 26.0f;
+    float comboWidth = 200.0f;
+    ImVec2 comboPadding = ImVec2(14, 5);
+    float popupRounding = 8.0f;
+};
+
+struct AppLayout
+{
+    ImVec2 display = ImVec2(LAYOUT_DESIGN_WIDTH, LAYOUT_DESIGN_HEIGHT);
+    ImVec2 center = ImVec2(LAYOUT_DESIGN_WIDTH * 0.5f, LAYOUT_DESIGN_HEIGHT * 0.5f);
+    float scale = 1.0f;             // design units -> window units
+    float pixelScale = 1.0f;        // window units -> framebuffer pixels (DPI)
+    float rootFontScale = 6.0f;
+
+    TabBarLayout tabs;
+    PomodoroLayout pomodoro;
+    WeatherLayout weather;
+    SettingsLayout settings;
+};
+
+// Image sizes the layout fits come from the texture registry (logo) and the
+// atlas (icons), so call after both are loaded
+void Layout_Init(GLuint logoTexture);
+
+// Recompute everything. Window size in window units, drawable size in
+// pixels (they differ on high-DPI displays). Call at startup and on
+// SDL_WINDOWEVENT_SIZE_CHANGED / SDL_WINDOWEVENT_DISPLAY_CHANGED.
+void Layout_Update(int windowWidth, int windowHeight, int drawableWidth, int drawableHeight);
+
+// The cached layout (UI thread)
+const AppLayout& Layout_Get();
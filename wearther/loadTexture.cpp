@@ -1,28 +1,268 @@
+// ============================================================================
+// Texture Loading
+// ============================================================================
+// Decodes images with stb_image, downsamples oversized assets to the size they
+// are actually drawn at, and uploads them as mipmapped RGBA8 textures.
+// Decoding is split from uploading so it can run on worker threads.
+
 #include <glad/glad.h>
 #define STB_IMAGE_IMPLEMENTATION
 #include "image.h"
 
-#include <SDL.h>
-#include <SDL_opengl.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
-#include "imgui.h"
-#include "imgui_impl_sdl2.h"
-#include "imgui_impl_opengl3.h"
+#include "loadTexture.h"
+#include "textureCache.h"
 
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_USE_SSE2 1
+#include <emmintrin.h>
+#endif
 
+// ============================================================================
+// TEXTURE REGISTRY
+// ============================================================================
 
-#include <iostream>
-#include <string>
-#include <sstream>
+// A handful of entries, so a linear scan beats hashing
+static std::vector<TextureInfo> registry;
 
-#include "loadTexture.h"
+// RGBA8 with a full mip chain costs ~4/3 of level 0
+static size_t MipmappedBytes(int width, int height)
+{
+    size_t base = (size_t)width * (size_t)height * 4;
+    return base + base / 3;
+}
+
+// ============================================================================
+// CPU DOWNSAMPLING
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Halve an RGBA8 image with a 2x2 box filter (SSE2 for the bulk of each row)
+// ----------------------------------------------------------------------------
+static void HalveRGBA(const unsigned char* src, int srcW, int srcH, unsigned char* dst)
+{
+    int dstW = srcW / 2;
+    int dstH = srcH / 2;
+
+    for (int y = 0; y < dstH; ++y)
+    {
+        const unsigned char* row0 = src + (size_t)(2 * y) * srcW * 4;
+        const unsigned char* row1 = row0 + (size_t)srcW * 4;
+        unsigned char* out = dst + (size_t)y * dstW * 4;
+
+        int x = 0;
+
+#ifdef TEXTURE_USE_SSE2
+        // 4 source pixels from each row -> 2 output pixels per iteration
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi16(2);
 
+        for (; x + 2 <= dstW; x += 2)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+            __m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
 
-static GLuint loadTexture(const char* filename)
+            __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+            __m128i p0 = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+            __m128i p1 = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+
+            __m128i sum = _mm_unpacklo_epi64(p0, p1);
+            sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+
+            _mm_storel_epi64((__m128i*)(out + x * 4), _mm_packus_epi16(sum, zero));
+        }
+#endif
+
+        for (; x < dstW; ++x)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                int sum = row0[x * 8 + c] + row0[x * 8 + 4 + c]
+                    + row1[x * 8 + c] + row1[x * 8 + 4 + c];
+                out[x * 4 + c] = (unsigned char)((sum + 2) >> 2);
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Area-weighted box resample for the remaining (< 2x) reduction
+// ----------------------------------------------------------------------------
+static void BoxResampleRGBA(const unsigned char* src, int srcW, int srcH,
+    unsigned char* dst, int dstW, int dstH)
+{
+    const float sx = (float)srcW / (float)dstW;
+    const float sy = (float)srcH / (float)dstH;
+    const float norm = 1.0f / (sx * sy);
+
+    for (int y = 0; y < dstH; ++y)
+    {
+        float y0 = y * sy;
+        float y1 = y0 + sy;
+        int iy0 = (int)y0;
+        int iy1 = std::min((int)std::ceil(y1), srcH);
+
+        for (int x = 0; x < dstW; ++x)
+        {
+            float x0 = x * sx;
+            float x1 = x0 + sx;
+            int ix0 = (int)x0;
+            int ix1 = std::min((int)std::ceil(x1), srcW);
+
+            float acc[4] = { 0, 0, 0, 0 };
+
+            for (int iy = iy0; iy < iy1; ++iy)
+            {
+                float wy = std::min(y1, (float)(iy + 1)) - std::max(y0, (float)iy);
+                const unsigned char* row = src + (size_t)iy * srcW * 4;
+
+                for (int ix = ix0; ix < ix1; ++ix)
+                {
+                    float w = wy * (std::min(x1, (float)(ix + 1)) - std::max(x0, (float)ix));
+                    const unsigned char* p = row + ix * 4;
+                    acc[0] += p[0] * w;
+                    acc[1] += p[1] * w;
+                    acc[2] += p[2] * w;
+                    acc[3] += p[3] * w;
+                }
+            }
+
+            unsigned char* out = dst + ((size_t)y * dstW + x) * 4;
+            for (int c = 0; c < 4; ++c) {
+                float v = acc[c] * norm + 0.5f;
+                out[c] = (unsigned char)std::clamp(v, 0.0f, 255.0f);
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Smallest size (keeping aspect ratio) that still covers the display size
+// ----------------------------------------------------------------------------
+static void ComputeTargetSize(int width, int height, int displayWidth, int displayHeight,
+    int& outWidth, int& outHeight)
+{
+    outWidth = width;
+    outHeight = height;
+
+    if (displayWidth <= 0 || displayHeight <= 0) return;
+
+    double scale = std::max(displayWidth / (double)width, displayHeight / (double)height);
+    if (scale >= 1.0) return;
+
+    outWidth = std::max(1, (int)std::ceil(width * scale));
+    outHeight = std::max(1, (int)std::ceil(height * scale));
+}
+
+// ----------------------------------------------------------------------------
+// Downsample to the target size: repeated 2x halving, then one box pass
+// ----------------------------------------------------------------------------
+static std::vector<unsigned char> DownsampleRGBA(const unsigned char* data,
+    int width, int height, int targetWidth, int targetHeight)
+{
+    // The first pass reads straight from the decoder's buffer
+    const unsigned char* current = data;
+    std::vector<unsigned char> result;
+    std::vector<unsigned char> next;
+
+    while (width / 2 >= targetWidth && height / 2 >= targetHeight)
+    {
+        next.resize((size_t)(width / 2) * (height / 2) * 4);
+        HalveRGBA(current, width, height, next.data());
+        result.swap(next);
+        current = result.data();
+        width /= 2;
+        height /= 2;
+    }
+
+    if (width != targetWidth || height != targetHeight)
+    {
+        next.resize((size_t)targetWidth * targetHeight * 4);
+        BoxResampleRGBA(current, width, height, next.data(), targetWidth, targetHeight);
+        result.swap(next);
+    }
+
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Next mip level (floor halving, clamped at 1 like GL)
+// ----------------------------------------------------------------------------
+static void NextMipLevel(const unsigned char* src, int srcW, int srcH, unsigned char* dst)
+{
+    if (srcW >= 2 && srcH >= 2) {
+        HalveRGBA(src, srcW, srcH, dst);
+        return;
+    }
+
+    // One dimension is already 1: average along the other one only
+    int dstW = srcW > 1 ? srcW / 2 : 1;
+    int dstH = srcH > 1 ? srcH / 2 : 1;
+    int stepX = srcW > 1 ? 1 : 0;
+    int stepY = srcH > 1 ? 1 : 0;
+
+    for (int y = 0; y < dstH; ++y) {
+        for (int x = 0; x < dstW; ++x) {
+            const unsigned char* a = src + ((size_t)(y * 2 * stepY) * srcW + x * 2 * stepX) * 4;
+            const unsigned char* b = src + ((size_t)((y * 2 + 1) * stepY) * srcW + (x * 2 + 1) * stepX) * 4;
+            for (int c = 0; c < 4; ++c) {
+                dst[((size_t)y * dstW + x) * 4 + c] = (unsigned char)((a[c] + b[c] + 1) >> 1);
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Append the full mip chain after level 0; returns the level count
+// ----------------------------------------------------------------------------
+static int AppendMipChain(std::vector<unsigned char>& pixels, int width, int height)
+{
+    size_t total = 0;
+    int levels = 1;
+    for (int w = width, h = height; w > 1 || h > 1; ++levels) {
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+        total += (size_t)w * h * 4;
+    }
+
+    size_t offset = 0;
+    pixels.resize(pixels.size() + total);
+
+    for (int i = 1; i < levels; ++i)
+    {
+        size_t levelBytes = (size_t)width * height * 4;
+        NextMipLevel(&pixels[offset], width, height, &pixels[offset + levelBytes]);
+        offset += levelBytes;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    return levels;
+}
+
+// ============================================================================
+// DECODE (any thread)
+// ============================================================================
+bool Texture_Decode(const char* filename, int displayWidth, int displayHeight,
+    DecodedImage& out, bool mipmaps)
 {
     if (!filename) {
-        std::cerr << "LoadTexture: filename is null\n";
-        return 0;
+        std::cerr << "[Texture] filename is null\n";
+        return false;
+    }
+
+    // Warm start: the finished mip chain is already on disk
+    if (TextureCache_Load(filename, displayWidth, displayHeight, mipmaps, out)) {
+        return true;
     }
 
     int width = 0, height = 0, channels = 0;
@@ -30,8 +270,68 @@ static GLuint loadTexture(const char* filename)
         stbi_load(filename, &width, &height, &channels, STBI_rgb_alpha);
 
     if (!data) {
-        std::cerr << "LoadTexture: failed to load " << filename << "\n";
-        return 0;
+        std::cerr << "[Texture] Failed to load " << filename << "\n";
+        return false;
+    }
+
+    int targetWidth = 0, targetHeight = 0;
+    ComputeTargetSize(width, height, displayWidth, displayHeight, targetWidth, targetHeight);
+
+    out.name = filename;
+    out.srcWidth = width;
+    out.srcHeight = height;
+    out.width = targetWidth;
+    out.height = targetHeight;
+    out.levels = 1;
+
+    if (targetWidth != width || targetHeight != height) {
+        out.pixels = DownsampleRGBA(data, width, height, targetWidth, targetHeight);
+    }
+    else {
+        out.pixels.assign(data, data + (size_t)width * height * 4);
+    }
+
+    stbi_image_free(data);
+
+    if (mipmaps) {
+        out.levels = AppendMipChain(out.pixels, targetWidth, targetHeight);
+    }
+
+    TextureCache_Store(filename, displayWidth, displayHeight, mipmaps, out);
+    return true;
+}
+
+// ============================================================================
+// UPLOAD (GL thread)
+// ============================================================================
+
+// Staging buffer reused across uploads; orphaned on every upload
+static GLuint stagingPbo = 0;
+
+GLuint Texture_Upload(const DecodedImage& image, int maxMipLevel)
+{
+    size_t size = image.ByteSize();
+    if (size == 0) return 0;
+
+    if (stagingPbo == 0) {
+        glGenBuffers(1, &stagingPbo);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingPbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size, nullptr, GL_STREAM_DRAW);
+
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    const unsigned char* source = nullptr;   // offsets into the bound PBO
+    if (mapped) {
+        std::memcpy(mapped, image.Bytes(), size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    else {
+        // Mapping failed: fall back to a plain client-memory upload
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        source = image.Bytes();
     }
 
     GLuint tex = 0;
@@ -42,18 +342,111 @@ static GLuint loadTexture(const char* filename)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    glTexImage2D(
-        GL_TEXTURE_2D, 0, GL_RGBA8,
-        width, height, 0,
-        GL_RGBA, GL_UNSIGNED_BYTE, data
-    );
+    if (image.levels > 1) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.levels - 1);
+    }
+    else if (maxMipLevel >= 0) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxMipLevel);
+    }
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+    size_t offset = 0;
+    int w = image.width, h = image.height;
+    for (int level = 0; level < image.levels; ++level)
+    {
+        glTexImage2D(
+            GL_TEXTURE_2D, level, GL_RGBA8,
+            w, h, 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, source + offset
+        );
+        offset += (size_t)w * h * 4;
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
 
+    if (image.levels == 1) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    TextureInfo info;
+    info.handle = tex;
+    info.name = image.name;
+    info.srcWidth = image.srcWidth;
+    info.srcHeight = image.srcHeight;
+    info.width = image.width;
+    info.height = image.height;
+    info.format = GL_RGBA8;
+    info.bytes = image.levels > 1 ? size : MipmappedBytes(image.width, image.height);
+    registry.push_back(std::move(info));
+
+    std::cout << "[Texture] Loaded " << image.name
+        << " (" << image.srcWidth << "x" << image.srcHeight;
+    if (image.width != image.srcWidth || image.height != image.srcHeight) {
+        std::cout << " -> " << image.width << "x" << image.height;
+    }
+    std::cout << (image.mapped ? ", cached" : "") << ")\n";
 
-    std::cout << "Loaded texture: " << filename
-        << " (" << width << "x" << height << ")\n";
     return tex;
 }
+
+void Texture_ReleaseStaging()
+{
+    if (stagingPbo != 0) {
+        glDeleteBuffers(1, &stagingPbo);
+        stagingPbo = 0;
+    }
+}
+
+// ============================================================================
+// TEXTURE LOADER (OpenGL)
+// ============================================================================
+GLuint LoadTexture(const char* filename, int displayWidth, int displayHeight)
+{
+    DecodedImage image;
+    if (!Texture_Decode(filename, displayWidth, displayHeight, image)) {
+        return 0;
+    }
+    return Texture_Upload(image);
+}
+
+const TextureInfo* Texture_GetInfo(GLuint handle)
+{
+    if (handle == 0) return nullptr;
+
+    for (const TextureInfo& info : registry) {
+        if (info.handle == handle) return &info;
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// VRAM BUDGET REPORT
+// ============================================================================
+void Texture_ReportBudget()
+{
+    size_t total = 0;
+    size_t totalUnscaled = 0;
+
+    std::streamsize oldPrecision = std::cout.precision();
+    std::cout << "[Texture] VRAM budget:\n" << std::fixed << std::setprecision(2);
+
+    for (const TextureInfo& e : registry)
+    {
+        size_t unscaled = MipmappedBytes(e.srcWidth, e.srcHeight);
+        total += e.bytes;
+        totalUnscaled += unscaled;
+
+        std::cout << "  " << e.name << ": "
+            << e.width << "x" << e.height << ", "
+            << e.bytes / (1024.0 * 1024.0) << " MB";
+        if (e.bytes != unscaled) {
+            std::cout << " (full size " << unscaled / (1024.0 * 1024.0) << " MB)";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "  total: " << total / (1024.0 * 1024.0) << " MB"
+        << " (full size " << totalUnscaled / (1024.0 * 1024.0) << " MB)\n";
+    std::cout << std::defaultfloat << std::setprecision(oldPrecision);
+}
@@ -1,8 +1,62 @@
 #pragma once
 #include <glad/glad.h>
 
+#include <memory>
+#include <string>
+#include <vector>
 
+// CPU-side RGBA8 image, already downsampled to its display size.
+// Level 0 is followed by `levels - 1` mip levels, back to back. The bytes
+// either live in `pixels` or in a memory-mapped texture cache entry.
+struct DecodedImage {
+    std::string name;
+    int srcWidth = 0;       // size on disk
+    int srcHeight = 0;
+    int width = 0;          // size to upload
+    int height = 0;
+    int levels = 1;
 
+    std::vector<unsigned char> pixels;          // owned storage (fresh decode)
+    std::shared_ptr<const void> mapping;        // keeps a cache entry mapped
+    const unsigned char* mapped = nullptr;      // levels inside the mapping
+    size_t mappedSize = 0;
 
+    const unsigned char* Bytes() const { return mapped ? mapped : pixels.data(); }
+    size_t ByteSize() const { return mapped ? mappedSize : pixels.size(); }
+};
 
-static GLuint loadTexture(const char* filename);
+// Decode + downsample (+ CPU mip chain) only. Touches no GL state, safe on
+// worker threads. If displayWidth/displayHeight are given, images larger
+// than that size are downsampled so they just cover the display size.
+// Results are cached on disk; warm starts map the cache instead of decoding.
+bool Texture_Decode(const char* filename, int displayWidth, int displayHeight,
+    DecodedImage& out, bool mipmaps = true);
+
+// Upload a decoded image through a staging PBO (GL thread). Images carrying a
+// mip chain upload it as-is; otherwise mips are generated on the GPU and
+// maxMipLevel caps the chain (-1 = full chain), e.g. for padded atlases.
+GLuint Texture_Upload(const DecodedImage& image, int maxMipLevel = -1);
+
+// Free the staging PBO once all uploads are done
+void Texture_ReleaseStaging();
+
+// Decode + upload in one step on the GL thread
+GLuint LoadTexture(const char* filename, int displayWidth = 0, int displayHeight = 0);
+
+// Metadata recorded once at upload so the frame loop never queries GL for it
+struct TextureInfo {
+    GLuint handle = 0;
+    std::string name;
+    int srcWidth = 0;       // size on disk (what layouts are written against)
+    int srcHeight = 0;
+    int width = 0;          // size on the GPU
+    int height = 0;
+    GLenum format = GL_RGBA8;
+    size_t bytes = 0;       // level 0 + mip chain
+};
+
+// Registry lookup; returns nullptr for 0 or unknown handles
+const TextureInfo* Texture_GetInfo(GLuint handle);
+
+// Print GPU memory used by every texture loaded so far
+void Texture_ReportBudget();
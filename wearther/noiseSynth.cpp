@@ -0,0 +1,425 @@
+// ============================================================================
+// Procedural Ambient Noise
+// ============================================================================
+// Every 64-frame block:
+//   1. control: advance the slow random modulators, retune the biquads
+//   2. four lanes of white noise (xorshift32, one SSE2 lane each)
+//   3. per-kind input shaping (rain drops gate lanes 2/3)
+//   4. the 4-lane biquad bank, all lanes in one SSE2 register
+//   5. lanes 0+2 -> left, 1+3 -> right, gains ramped across the block
+// Lanes 0/1 and 2/3 get independent noise, so the stereo image is wide.
+
+#include "noiseSynth.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SYNTH_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+static constexpr int LANES = 4;
+static constexpr int BLOCK = 64;
+static constexpr float PI = 3.14159265f;
+
+// Drop-gated input never goes fully silent, which keeps the filter state out
+// of denormals (-80 dB, inaudible)
+static constexpr float DROP_FLOOR = 1e-4f;
+
+// ============================================================================
+// BIQUAD BANK
+// ============================================================================
+
+enum FilterType { LOWPASS, HIGHPASS, BANDPASS };
+
+// Transposed direct form II, one filter per lane
+struct alignas(16) BiquadBank
+{
+    float b0[LANES], b1[LANES], b2[LANES], a1[LANES], a2[LANES];
+    float z1[LANES], z2[LANES];
+};
+
+// RBJ cookbook coefficients
+static void SetBiquad(BiquadBank& bank, int lane, FilterType type, float fc, float q, float fs)
+{
+    float w0 = 2.0f * PI * std::clamp(fc, 10.0f, fs * 0.45f) / fs;
+    float cw = std::cos(w0);
+    float alpha = std::sin(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+
+    float b0, b1, b2;
+    switch (type)
+    {
+    case LOWPASS:  b0 = (1.0f - cw) * 0.5f; b1 = 1.0f - cw;    b2 = b0;     break;
+    case HIGHPASS: b0 = (1.0f + cw) * 0.5f; b1 = -(1.0f + cw); b2 = b0;     break;
+    default:       b0 = alpha;              b1 = 0.0f;         b2 = -alpha; break;
+    }
+
+    bank.b0[lane] = b0 / a0;
+    bank.b1[lane] = b1 / a0;
+    bank.b2[lane] = b2 / a0;
+    bank.a1[lane] = -2.0f * cw / a0;
+    bank.a2[lane] = (1.0f - alpha) / a0;
+}
+
+// x and y are lane-interleaved: [frame * LANES + lane]
+static void ProcessBank(BiquadBank& bank, const float* x, float* y, int frames)
+{
+#ifdef SYNTH_USE_SSE2
+    const __m128 b0 = _mm_load_ps(bank.b0);
+    const __m128 b1 = _mm_load_ps(bank.b1);
+    const __m128 b2 = _mm_load_ps(bank.b2);
+    const __m128 a1 = _mm_load_ps(bank.a1);
+    const __m128 a2 = _mm_load_ps(bank.a2);
+    __m128 z1 = _mm_load_ps(bank.z1);
+    __m128 z2 = _mm_load_ps(bank.z2);
+
+    for (int f = 0; f < frames; ++f)
+    {
+        __m128 in = _mm_load_ps(x + f * LANES);
+        __m128 out = _mm_add_ps(_mm_mul_ps(b0, in), z1);
+        z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, in), _mm_mul_ps(a1, out)), z2);
+        z2 = _mm_sub_ps(_mm_mul_ps(b2, in), _mm_mul_ps(a2, out));
+        _mm_store_ps(y + f * LANES, out);
+    }
+
+    _mm_store_ps(bank.z1, z1);
+    _mm_store_ps(bank.z2, z2);
+#else
+    for (int f = 0; f < frames; ++f)
+    {
+        for (int l = 0; l < LANES; ++l)
+        {
+            float in = x[f * LANES + l];
+            float out = bank.b0[l] * in + bank.z1[l];
+            bank.z1[l] = bank.b1[l] * in - bank.a1[l] * out + bank.z2[l];
+            bank.z2[l] = bank.b2[l] * in - bank.a2[l] * out;
+            y[f * LANES + l] = out;
+        }
+    }
+#endif
+}
+
+// ============================================================================
+// MODULATION
+// ============================================================================
+
+static uint32_t NextRandom(uint32_t& s)
+{
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+static float Random01(uint32_t& s)
+{
+    return (NextRandom(s) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Value gliding towards a new random target every `seconds` or so
+struct Drift
+{
+    float lo = 0.0f;
+    float hi = 1.0f;
+    float seconds = 1.0f;
+    float value = 0.5f;
+    float target = 0.5f;
+    float timer = 0.0f;
+
+    void Update(float dt, uint32_t& rng)
+    {
+        timer -= dt;
+        if (timer <= 0.0f) {
+            target = lo + (hi - lo) * Random01(rng);
+            timer = seconds * (0.5f + Random01(rng));
+        }
+        value += (target - value) * std::min(1.0f, dt / seconds);
+    }
+};
+
+static Drift MakeDrift(float lo, float hi, float seconds)
+{
+    Drift d;
+    d.lo = lo;
+    d.hi = hi;
+    d.seconds = seconds;
+    d.value = d.target = (lo + hi) * 0.5f;
+    return d;
+}
+
+// ============================================================================
+// SYNTH
+// ============================================================================
+
+struct NoiseSynth
+{
+    alignas(16) float x[BLOCK * LANES];
+    alignas(16) float y[BLOCK * LANES];
+    alignas(16) uint32_t seed[LANES];
+    BiquadBank bank;
+
+    SynthKind kind;
+    float fs;
+    uint32_t control;           // scalar RNG for modulation and drops
+
+    float gain[LANES];          // applied at the end of the last block
+    Drift level;
+    Drift tone;
+
+    // Rain: per-side drop envelope
+    float drop[2];
+    float dropDecay;
+    float dropChance;           // per frame
+
+    // Surf: swell cycle
+    float swellPhase;
+    float swellPeriod;
+    float wash;                 // lagging swell for the hiss lanes
+
+    float out[BLOCK * 2];       // rendered stereo block
+    int outPos;
+};
+
+// Swell shape over one wave: quick smooth rise, long exponential fall
+static float SwellShape(float phase)
+{
+    if (phase < 0.35f) {
+        float s = std::sin(phase / 0.35f * PI * 0.5f);
+        return s * s;
+    }
+    return std::exp(-(phase - 0.35f) * 4.0f);
+}
+
+static void Control(NoiseSynth& s, float target[LANES])
+{
+    const float dt = BLOCK / s.fs;
+    s.level.Update(dt, s.control);
+    s.tone.Update(dt, s.control);
+
+    switch (s.kind)
+    {
+    case SYNTH_RAIN:
+        // Steady hiss plus drops; level drifts a little
+        target[0] = target[1] = 0.30f * s.level.value;
+        target[2] = target[3] = 0.55f;
+        break;
+
+    case SYNTH_SURF:
+    {
+        s.swellPhase += dt / s.swellPeriod;
+        if (s.swellPhase >= 1.0f) {
+            s.swellPhase -= 1.0f;
+            s.swellPeriod = 6.0f + 5.0f * Random01(s.control);
+        }
+        float swell = 0.15f + 0.85f * SwellShape(s.swellPhase);
+        s.wash += (swell - s.wash) * std::min(1.0f, dt / 1.2f);
+
+        // Roar opens up as the wave breaks
+        float fc = 300.0f + 500.0f * swell;
+        SetBiquad(s.bank, 0, LOWPASS, fc, 0.707f, s.fs);
+        SetBiquad(s.bank, 1, LOWPASS, fc * 1.05f, 0.707f, s.fs);
+
+        target[0] = target[1] = 1.10f * swell * s.level.value;
+        target[2] = target[3] = 0.45f * s.wash;
+        break;
+    }
+
+    case SYNTH_WIND:
+    {
+        // Narrow band sweeping slowly; the rumble follows the gusts
+        float fc = s.tone.value;
+        SetBiquad(s.bank, 0, BANDPASS, fc, 3.0f, s.fs);
+        SetBiquad(s.bank, 1, BANDPASS, fc * 1.08f, 3.0f, s.fs);
+
+        target[0] = target[1] = 1.90f * s.level.value;
+        target[2] = target[3] = 0.40f * (0.5f + 0.5f * s.level.value);
+        break;
+    }
+    }
+}
+
+static void FillNoise(NoiseSynth& s)
+{
+#ifdef SYNTH_USE_SSE2
+    __m128i state = _mm_load_si128((const __m128i*)s.seed);
+    const __m128 scale = _mm_set1_ps(1.0f / 2147483648.0f);
+
+    for (int f = 0; f < BLOCK; ++f)
+    {
+        state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+        state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+        state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+        _mm_store_ps(s.x + f * LANES, _mm_mul_ps(_mm_cvtepi32_ps(state), scale));
+    }
+
+    _mm_store_si128((__m128i*)s.seed, state);
+#else
+    for (int f = 0; f < BLOCK; ++f) {
+        for (int l = 0; l < LANES; ++l) {
+            s.x[f * LANES + l] = (int32_t)NextRandom(s.seed[l]) * (1.0f / 2147483648.0f);
+        }
+    }
+#endif
+}
+
+static void RenderBlock(NoiseSynth& s)
+{
+    float target[LANES];
+    Control(s, target);
+    FillNoise(s);
+
+    if (s.kind == SYNTH_RAIN)
+    {
+        // Lanes 2/3: noise bursts of a few ms at random, one per drop
+        for (int f = 0; f < BLOCK; ++f) {
+            for (int side = 0; side < 2; ++side) {
+                float& env = s.drop[side];
+                env = std::max(env * s.dropDecay, DROP_FLOOR);
+                if (Random01(s.control) < s.dropChance) {
+                    env = 0.3f + 0.7f * Random01(s.control);
+                }
+                s.x[f * LANES + 2 + side] *= env;
+            }
+        }
+    }
+
+    ProcessBank(s.bank, s.x, s.y, BLOCK);
+
+    // Ramp gains across the block so modulation never steps
+    float step[LANES];
+    for (int l = 0; l < LANES; ++l) {
+        step[l] = (target[l] - s.gain[l]) / BLOCK;
+    }
+
+    for (int f = 0; f < BLOCK; ++f)
+    {
+        for (int l = 0; l < LANES; ++l) s.gain[l] += step[l];
+        const float* y = s.y + f * LANES;
+        s.out[f * 2 + 0] = y[0] * s.gain[0] + y[2] * s.gain[2];
+        s.out[f * 2 + 1] = y[1] * s.gain[1] + y[3] * s.gain[3];
+    }
+    s.outPos = 0;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+NoiseSynth* Synth_Create(SynthKind kind, int frequency)
+{
+    NoiseSynth* s = new NoiseSynth();
+    s->kind = kind;
+    s->fs = (float)frequency;
+    s->control = 0x9E3779B9u ^ (uint32_t)kind;
+    for (int l = 0; l < LANES; ++l) {
+        s->seed[l] = 0x1234567u * (l + 1) + 0x51u * (uint32_t)kind;
+    }
+    std::fill(std::begin(s->gain), std::end(s->gain), 0.0f);
+    s->outPos = BLOCK;
+
+    s->drop[0] = s->drop[1] = DROP_FLOOR;
+    s->dropDecay = std::exp(-1.0f / (0.004f * s->fs));     // ~4 ms per drop
+    s->dropChance = 70.0f / s->fs;                          // ~70 drops/s a side
+
+    s->swellPhase = 0.0f;
+    s->swellPeriod = 8.0f;
+    s->wash = 0.0f;
+
+    switch (kind)
+    {
+    case SYNTH_RAIN:
+        s->level = MakeDrift(0.8f, 1.2f, 6.0f);
+        s->tone = MakeDrift(0.0f, 0.0f, 1.0f);
+        SetBiquad(s->bank, 0, BANDPASS, 3500.0f, 0.5f, s->fs);
+        SetBiquad(s->bank, 1, BANDPASS, 3800.0f, 0.5f, s->fs);
+        SetBiquad(s->bank, 2, BANDPASS, 1800.0f, 1.2f, s->fs);
+        SetBiquad(s->bank, 3, BANDPASS, 2000.0f, 1.2f, s->fs);
+        break;
+
+    case SYNTH_SURF:
+        s->level = MakeDrift(0.8f, 1.1f, 10.0f);
+        s->tone = MakeDrift(0.0f, 0.0f, 1.0f);
+        SetBiquad(s->bank, 0, LOWPASS, 400.0f, 0.707f, s->fs);
+        SetBiquad(s->bank, 1, LOWPASS, 420.0f, 0.707f, s->fs);
+        SetBiquad(s->bank, 2, BANDPASS, 2500.0f, 0.5f, s->fs);
+        SetBiquad(s->bank, 3, BANDPASS, 2700.0f, 0.5f, s->fs);
+        break;
+
+    case SYNTH_WIND:
+        s->level = MakeDrift(0.25f, 1.0f, 3.0f);
+        s->tone = MakeDrift(250.0f, 800.0f, 4.0f);
+        SetBiquad(s->bank, 0, BANDPASS, 500.0f, 3.0f, s->fs);
+        SetBiquad(s->bank, 1, BANDPASS, 540.0f, 3.0f, s->fs);
+        SetBiquad(s->bank, 2, LOWPASS, 180.0f, 0.707f, s->fs);
+        SetBiquad(s->bank, 3, LOWPASS, 190.0f, 0.707f, s->fs);
+        break;
+    }
+    return s;
+}
+
+void Synth_Destroy(NoiseSynth* synth)
+{
+    delete synth;
+}
+
+void Synth_Render(NoiseSynth* synth, float* out, int frames, int channels)
+{
+    NoiseSynth& s = *synth;
+
+    for (int f = 0; f < frames; ++f)
+    {
+        if (s.outPos == BLOCK) RenderBlock(s);
+
+        float l = s.out[s.outPos * 2 + 0];
+        float r = s.out[s.outPos * 2 + 1];
+        s.outPos++;
+
+        float* dst = out + (size_t)f * channels;
+        if (channels == 1) {
+            dst[0] = (l + r) * 0.5f;
+            continue;
+        }
+        dst[0] = l;
+        dst[1] = r;
+        for (int c = 2; c < channels; ++c) dst[c] = 0.0f;
+    }
+}
+
+const char* Synth_Name(SynthKind kind)
+{
+    switch (kind)
+    {
+    case SYNTH_RAIN: return "rain";
+    case SYNTH_SURF: return "surf";
+    case SYNTH_WIND: return "wind";
+    }
+    return "?";
+}
+
+size_t Synth_StateBytes()
+{
+    return sizeof(NoiseSynth);
+}
+
+double Synth_Benchmark(SynthKind kind, int frequency)
+{
+    static constexpr int SECONDS = 2;
+    static constexpr int CHUNK = 512;
+
+    NoiseSynth* s = Synth_Create(kind, frequency);
+    std::vector<float> buffer(CHUNK * 2);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int done = 0; done < frequency * SECONDS; done += CHUNK) {
+        Synth_Render(s, buffer.data(), CHUNK, 2);
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start);
+
+    Synth_Destroy(s);
+    return elapsed.count() / SECONDS;
+}
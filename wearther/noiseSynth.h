@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+// Procedural ambient noise: rain, surf and wind shaped from white noise by a
+// bank of four biquads run side by side (one SSE2 lane each). Slow random
+// modulation means there is no loop to hear, and the whole generator is a
+// few kilobytes of state instead of megabytes of PCM.
+
+// Order matches the Settings preset list
+enum SynthKind {
+    SYNTH_RAIN,
+    SYNTH_SURF,
+    SYNTH_WIND,
+};
+
+struct NoiseSynth;
+
+NoiseSynth* Synth_Create(SynthKind kind, int frequency);
+void Synth_Destroy(NoiseSynth* synth);
+
+// Overwrites `frames` interleaved frames (the first two channels carry the
+// stereo image, any others are left silent). Audio-thread safe: no
+// allocation, no locks.
+void Synth_Render(NoiseSynth* synth, float* out, int frames, int channels);
+
+const char* Synth_Name(SynthKind kind);
+size_t Synth_StateBytes();
+
+// CPU time to render one second of audio, in microseconds (renders a couple
+// of seconds offline on the calling thread)
+double Synth_Benchmark(SynthKind kind, int frequency);
@@ -23,6 +23,14 @@
 #include "http.h"
 #include "time.h"
 #include "audio.h"
+#include "ambientStream.h"
+#include "loadTexture.h"
+#include "textureAtlas.h"
+#include "cachedLabel.h"
+#include "deadlineTimer.h"
+#include "timerWheel.h"
+#include "settingsStore.h"
+#include "layout.h"
 // ============================================================================
 // GLOBAL STATE VARIABLES
 // ============================================================================
@@ -35,6 +43,11 @@ static bool resumeButtonstate = true;    // true = show logo screen, false = sho
 static std::string currentTime1 = "00:00:00";
 static double lastTimeUpdate1 = 0.0;
 
+// Label Cache (reformatted only when the shown values change)
+static CachedLabel statsLabel;
+static CachedLabel sessionLabelText;
+static CachedLabel timerLabel;
+
 // Timer State Machine
 enum TimerState {
     TIMER_FOCUS,        // Focus/work session
@@ -43,38 +56,22 @@ enum TimerState {
     SESSION_ENDED
 };
 
-// Pomodoro Configuration Structure
-struct pomedero {
-    int rounds;         // Number of rounds to complete
-    int focusTime;      // Focus session duration (minutes)
-    int shortBreak;     // Short break duration (minutes)
-    int longBreak;      // Long break duration (minutes)
-};
-
-// Default pomodoro settings
-static pomedero pom = { 1, 25, 5, 0 };  // longBreak = 0 initially since rounds = 1
+// Pomodoro configuration, persisted by the settings store (defaults there:
+// 1 round, 25/5/0 minutes). Mark SETTINGS_POMODORO dirty after changing it.
+static PomodoroSettings& pom = SettingsStore_Get().pomodoro;
 
 // Timer State Variables (persist between function calls)
 static TimerState currentState = TIMER_FOCUS;
 static int currentRound = 1;                    // Current round number (1 to rounds)
-static int countdownSeconds = 25 * 60;          // Countdown in seconds
-static double lastTick = 0.0;                   // Last time we updated the countdown
+static DeadlineTimer countdown;                  // Current session's countdown
+static TimerId sessionTimer = 0;                // Wheel timer firing at its deadline
 static bool timerInitialized = false;           // Has timer been initialized?
 
-// Button Scaling and Positioning (for bottom control buttons)
-static float stopScale = 0.5f;
-static float startScale = 0.5f;
-static float resetScale = 0.5f;
+// Button sizes and positions are cached in layout.cpp (PomodoroLayout)
 
-static ImVec2 stopOffset = ImVec2(0, 0);
-static ImVec2 startOffset = ImVec2(20, 10);
-static ImVec2 resetOffset = ImVec2(-20, -30);
 
+// audio varibles (the ambient loop is the streamed Ambient_ track)
 
-
-// audio varibles 
-
-int ch1 = -1;
 int ch2 = -1;
 int ch1playing = -1;
 int ch2playing = -1;
@@ -84,71 +81,67 @@ int ch2playing = -1;
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// Get scaled texture size to fit within a maximum box while keeping aspect ratio
+// Scale a size to fit within a maximum box while keeping aspect ratio
 // ----------------------------------------------------------------------------
-ImVec2 GetScaledSizeFromGLTexture(GLuint glTex, const ImVec2& maxBox)
+static ImVec2 ScaleToFit(const ImVec2& size, const ImVec2& maxBox)
 {
-    // If texture is invalid, return the max box size
-    if (glTex == 0) {
+    // If dimensions are invalid, return the max box size
+    if (size.x <= 0 || size.y <= 0) {
         return maxBox;
     }
 
-    // Save current texture binding so we can restore it later
-    GLint previousTexture = 0;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
-
-    // Bind our texture to query its properties
-    glBindTexture(GL_TEXTURE_2D, glTex);
+    // Calculate scale factor to fit within max box while keeping aspect ratio
+    float scaleX = maxBox.x / size.x;
+    float scaleY = maxBox.y / size.y;
+    float scale = std::min(scaleX, scaleY);  // Use smaller scale to fit in box
 
-    // Get the actual width and height of the texture
-    int width = 0;
-    int height = 0;
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    // Return scaled dimensions
+    return ImVec2(size.x * scale, size.y * scale);
+}
 
-    // Restore previous texture binding
-    glBindTexture(GL_TEXTURE_2D, previousTexture);
+// ----------------------------------------------------------------------------
+// Get scaled texture size to fit within a maximum box while keeping aspect ratio
+// ----------------------------------------------------------------------------
+ImVec2 GetScaledSizeFromGLTexture(GLuint glTex, const ImVec2& maxBox)
+{
+    // Size comes from the registry filled at load time - no GL queries here
+    const TextureInfo* info = Texture_GetInfo(glTex);
 
-    // If texture dimensions are invalid, return max box size
-    if (width <= 0 || height <= 0) {
+    // If texture is unknown, return the max box size
+    if (!info) {
         return maxBox;
     }
 
-    // Calculate scale factor to fit within max box while keeping aspect ratio
-    float scaleX = maxBox.x / (float)width;
-    float scaleY = maxBox.y / (float)height;
-    float scale = std::min(scaleX, scaleY);  // Use smaller scale to fit in box
-
-    // Return scaled dimensions
-    return ImVec2(width * scale, height * scale);
+    return ScaleToFit(ImVec2((float)info->srcWidth, (float)info->srcHeight), maxBox);
 }
 
 // ----------------------------------------------------------------------------
-// Get raw (unscaled) texture dimensions
+// Get raw (unscaled) texture dimensions - the source image size, which stays
+// the same even if the texture was downsampled on upload
 // ----------------------------------------------------------------------------
 ImVec2 GetRawTexSize(GLuint tex)
 {
+    const TextureInfo* info = Texture_GetInfo(tex);
+
     // If texture is invalid, return zero size
-    if (tex == 0) {
+    if (!info) {
         return ImVec2(0, 0);
     }
 
-    // Save current texture binding
-    GLint previousTexture = 0;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
-
-    // Bind texture and query its size
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    int width = 0;
-    int height = 0;
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    return ImVec2((float)info->srcWidth, (float)info->srcHeight);
+}
 
-    // Restore previous texture
-    glBindTexture(GL_TEXTURE_2D, previousTexture);
+// ----------------------------------------------------------------------------
+// When an idle main loop has to wake to redraw the countdown: every displayed
+// second while it is on screen (the session change itself is a wheel timer)
+// ----------------------------------------------------------------------------
+std::chrono::steady_clock::time_point Pomodoro_NextWake(bool countdownVisible)
+{
+    if (!countdownVisible || resumeButtonstate || !timerInitialized) {
+        return std::chrono::steady_clock::time_point::max();
+    }
 
-    return ImVec2((float)width, (float)height);
+    return Timer_NextChange(countdown, std::chrono::steady_clock::now());
 }
 
 // ----------------------------------------------------------------------------
@@ -160,6 +153,7 @@ void ApplyPomodoroDefaults()
     pom.focusTime = 25;
     pom.shortBreak = 5;
     pom.longBreak = 0;  // 0 because rounds < 4
+    SettingsStore_MarkDirty(SETTINGS_POMODORO);
 }
 
 // ----------------------------------------------------------------------------
@@ -171,21 +165,23 @@ void StartTimerSession(TimerState newState)
     currentState = newState;
 
     // Set countdown time based on session type
+    int seconds = 0;
     if (newState == TIMER_FOCUS) {
-        countdownSeconds = 25*60;
+        seconds = 25*60;
     }
     else if (newState == TIMER_SHORT_BREAK) {
-        countdownSeconds = 5*60;
+        seconds = 5*60;
     }
     else if (newState == TIMER_LONG_BREAK) {
-        countdownSeconds = 40*60;
+        seconds = 40*60;
     }
     else if (newState == SESSION_ENDED) {
-        countdownSeconds = 5;  
+        seconds = 5;  
     }
 
-    // Reset the tick timer
-    lastTick = ImGui::GetTime();
+    // Continue from the previous deadline, so no time is lost between
+    // sessions whatever the frame rate
+    Timer_Chain(countdown, std::chrono::seconds(seconds));
 }
 
 // ----------------------------------------------------------------------------
@@ -201,11 +197,10 @@ void AdvanceToNextSession(std::vector< Mix_Chunk*> audiofiles)
         // Check if we just finished the last round
         if (currentRound >= pom.rounds) {
             // All rounds complete - show session ended
-            Audio_StopChannel(ch1);
+            Ambient_Pause();
             ch1playing = 0;
-            ch1 = -1;
             StartTimerSession(SESSION_ENDED);
-            ch2 = Audio_PlayOnce(audiofiles[1]);
+            ch2 = Audio_PlayOnce(audiofiles[0]);
             return;
         }
 
@@ -222,12 +217,12 @@ void AdvanceToNextSession(std::vector< Mix_Chunk*> audiofiles)
 
         // Decide which break to give
         if (shouldGiveLongBreak) {
-            ch2 = Audio_PlayOnce(audiofiles[1]);
+            ch2 = Audio_PlayOnce(audiofiles[0]);
             StartTimerSession(TIMER_LONG_BREAK);
             
         }
         else {
-            ch2 = Audio_PlayOnce(audiofiles[1]);
+            ch2 = Audio_PlayOnce(audiofiles[0]);
             StartTimerSession(TIMER_SHORT_BREAK);
            
         }
@@ -235,13 +230,13 @@ void AdvanceToNextSession(std::vector< Mix_Chunk*> audiofiles)
     else if (currentState == TIMER_SHORT_BREAK) {
         // After short break, increment round and start next focus
         currentRound++;
-        ch2 = Audio_PlayOnce(audiofiles[1]);
+        ch2 = Audio_PlayOnce(audiofiles[0]);
         StartTimerSession(TIMER_FOCUS);
     }
     else if (currentState == TIMER_LONG_BREAK) {
         // After long break, increment round and start next focus
         currentRound++;
-        ch2 = Audio_PlayOnce(audiofiles[1]);
+        ch2 = Audio_PlayOnce(audiofiles[0]);
         StartTimerSession(TIMER_FOCUS);
     }
     else if (currentState == SESSION_ENDED) {
@@ -258,9 +253,8 @@ void AdvanceToNextSession(std::vector< Mix_Chunk*> audiofiles)
         // Reset timer state
         currentRound = 1;
         currentState = TIMER_FOCUS;
-        countdownSeconds = pom.focusTime * 60;
+        Timer_Set(countdown, std::chrono::minutes(pom.focusTime));
         timerInitialized = false;
-        lastTick = ImGui::GetTime();
 
         // Return to logo screen
         resumeButtonstate = true;
@@ -268,6 +262,26 @@ void AdvanceToNextSession(std::vector< Mix_Chunk*> audiofiles)
    
 }
 
+// ----------------------------------------------------------------------------
+// Keep the "pomodoro.session" wheel timer on the countdown's deadline, so the
+// session advances (and the alarm plays) on time whichever tab is open
+// ----------------------------------------------------------------------------
+static void ScheduleSessionEnd(const std::vector<Mix_Chunk*>& audiofiles)
+{
+    Timers_Cancel(sessionTimer);
+    sessionTimer = 0;
+
+    if (!countdown.running) return;
+
+    sessionTimer = Timers_AddAt("pomodoro.session", countdown.deadline,
+        [audiofiles](TimerId)
+        {
+            sessionTimer = 0;
+            AdvanceToNextSession(audiofiles);
+            ScheduleSessionEnd(audiofiles);
+        });
+}
+
 // ============================================================================
 // MAIN UI FUNCTION
 // ============================================================================
@@ -287,10 +301,18 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
     if (!resumeButtonstate && !timerInitialized) {
         // User pressed START from logo screen - initialize timer
         currentRound = 1;
+        Timer_Set(countdown, std::chrono::seconds(0));
         StartTimerSession(TIMER_FOCUS);
+        if (startButtonState) {
+            Timer_Resume(countdown, std::chrono::steady_clock::now());
+        }
+        ScheduleSessionEnd(audiofiles);
         timerInitialized = true;
     }
 
+    // Recomputed on resize only
+    const PomodoroLayout& lay = Layout_Get().pomodoro;
+
     // ------------------------------------------------------------------------
     // BACKGROUND IMAGE (full screen)
     // ------------------------------------------------------------------------
@@ -330,26 +352,16 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
         // --------------------------------------------------------------------
         // LOGO IMAGE (centered)
         // --------------------------------------------------------------------
-        ImVec2 logoMaxSize = ImVec2(500, 500);
-        ImVec2 logoScaled = GetScaledSizeFromGLTexture(
-            textures.size() > 2 ? textures[2] : 0,
-            logoMaxSize
-        );
-
-        // Calculate position to center logo
-        float logoX = (io.DisplaySize.x - logoScaled.x) * 0.5f;
-        float logoY = (io.DisplaySize.y - logoScaled.y) * 0.5f - 90;  
-
-        ImGui::SetNextWindowPos(ImVec2(logoX, logoY));
-        ImGui::SetNextWindowSize(logoScaled);
+        ImGui::SetNextWindowPos(lay.logo.pos);
+        ImGui::SetNextWindowSize(lay.logo.size);
 
         ImGui::Begin("Logo1", nullptr,
             ImGuiWindowFlags_NoDecoration |
             ImGuiWindowFlags_NoBackground |
             ImGuiWindowFlags_NoInputs);      // No input - logo is just for display
 
-        if (textures.size() > 2) {
-            ImGui::Image((ImTextureID)(intptr_t)textures[2], logoScaled);
+        if (textures.size() > 1) {
+            ImGui::Image((ImTextureID)(intptr_t)textures[1], lay.logo.size);
         }
 
         ImGui::End();
@@ -357,17 +369,12 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
         // --------------------------------------------------------------------
         // ARROW BUTTONS (increase/decrease rounds)
         // --------------------------------------------------------------------
-        ImVec2 arrowMaxSize = ImVec2(150, 150);
-        ImVec2 arrowScaled = GetScaledSizeFromGLTexture(
-            textures.size() > 3 ? textures[3] : 0,
-            arrowMaxSize
-        );
+        const AtlasRegion& arrowIcon = Atlas_Get(ICON_ARROW);
 
         // RIGHT ARROW - Increase rounds
         {
-            ImVec2 pos = ImVec2(logoX + logoScaled.x + 50.0f, logoY + logoScaled.y * 0.2f);
-            ImGui::SetNextWindowPos(pos);
-            ImGui::SetNextWindowSize(ImVec2(arrowScaled.x + 10, arrowScaled.y + 10));
+            ImGui::SetNextWindowPos(lay.arrowRight.pos);
+            ImGui::SetNextWindowSize(lay.arrowRight.size);
 
             ImGui::Begin("ArrowRight1", nullptr,
                 ImGuiWindowFlags_NoDecoration |
@@ -378,8 +385,9 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1, 1, 1, 0.1f));
             ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(1, 1, 1, 0.2f));
 
-            ImGui::SetCursorPos(ImVec2(5, 5));
-            if (ImGui::ImageButton("##ArrowInc", (ImTextureID)(intptr_t)textures[3], arrowScaled))
+            ImGui::SetCursorPos(lay.arrowCursor);
+            if (ImGui::ImageButton("##ArrowInc", (ImTextureID)(intptr_t)arrowIcon.texture, lay.arrowImage,
+                arrowIcon.uv0, arrowIcon.uv1))
             {
                 // Increase round count
                 pom.rounds++;
@@ -388,6 +396,7 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
                 pom.focusTime = 25 * pom.rounds;
                 pom.longBreak = ((pom.rounds) / 4) * 40;
                 pom.shortBreak = ((pom.rounds) - (pom.longBreak / 40)) * 5;
+                SettingsStore_MarkDirty(SETTINGS_POMODORO);
             }
 
             ImGui::PopStyleColor(3);
@@ -396,9 +405,8 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
 
         // LEFT ARROW - Decrease rounds
         {
-            ImVec2 pos = ImVec2(logoX - arrowScaled.x - 70.0f, logoY + logoScaled.y * 0.2f);
-            ImGui::SetNextWindowPos(pos);
-            ImGui::SetNextWindowSize(ImVec2(arrowScaled.x + 10, arrowScaled.y + 10));
+            ImGui::SetNextWindowPos(lay.arrowLeft.pos);
+            ImGui::SetNextWindowSize(lay.arrowLeft.size);
 
             ImGui::Begin("ArrowLeft1", nullptr,
                 ImGuiWindowFlags_NoDecoration |
@@ -408,11 +416,11 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1, 1, 1, 0.1f));
             ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(1, 1, 1, 0.2f));
 
-            ImGui::SetCursorPos(ImVec2(5, 5));
+            ImGui::SetCursorPos(lay.arrowCursor);
 
-            // Flip arrow image horizontally by swapping UV coordinates
-            if (ImGui::ImageButton("##ArrowDec", (ImTextureID)(intptr_t)textures[3], arrowScaled,
-                ImVec2(1, 0), ImVec2(0, 1)))
+            // Flip arrow image horizontally by swapping UV x coordinates
+            if (ImGui::ImageButton("##ArrowDec", (ImTextureID)(intptr_t)arrowIcon.texture, lay.arrowImage,
+                ImVec2(arrowIcon.uv1.x, arrowIcon.uv0.y), ImVec2(arrowIcon.uv0.x, arrowIcon.uv1.y)))
             {
                 // Decrease rounds, minimum 1
                 if (pom.rounds > 1) {
@@ -423,6 +431,7 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
                 pom.focusTime = 25 * pom.rounds;
                 pom.longBreak = ((pom.rounds) / 4) * 40;
                 pom.shortBreak = ((pom.rounds) - (pom.longBreak / 40)) * 5;
+                SettingsStore_MarkDirty(SETTINGS_POMODORO);
             }
 
             ImGui::PopStyleColor(3);
@@ -432,23 +441,21 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
 
         ImGui::PushFont(bigFont);
 
-        std::string statsText =
-            "Rounds: " + std::to_string(pom.rounds) +
-            "    FocusTime: " + std::to_string(pom.focusTime) +
-            "    ShortBreak: " + std::to_string(pom.shortBreak) +
-            "    LongBreak: " + std::to_string(pom.longBreak);
-
         // Calculate text size for centering
-        ImGui::SetWindowFontScale(6.0f);
-        ImVec2 textSize = ImGui::CalcTextSize(statsText.c_str());
+        ImGui::SetWindowFontScale(lay.statsFontScale);
+        const CachedLabel& statsText = Label_Update(statsLabel,
+            Label_Key(pom.rounds, pom.focusTime, pom.shortBreak, pom.longBreak),
+            "Rounds: %d    FocusTime: %d    ShortBreak: %d    LongBreak: %d",
+            pom.rounds, pom.focusTime, pom.shortBreak, pom.longBreak);
+        ImVec2 textSize = statsText.size;
         ImGui::SetWindowFontScale(1.0f);
 
         // Position text centered, below logo
         ImGui::SetNextWindowPos(ImVec2(
             (io.DisplaySize.x - textSize.x) * 0.5f,
-            io.DisplaySize.y * 0.5f + 120
+            lay.statsY
         ));
-        ImGui::SetNextWindowSize(ImVec2(textSize.x + 20, textSize.y + 20));
+        ImGui::SetNextWindowSize(ImVec2(textSize.x + lay.statsPadding, textSize.y + lay.statsPadding));
 
         ImGui::Begin("Stats1", nullptr,
             ImGuiWindowFlags_NoDecoration |
@@ -457,8 +464,8 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
 
         // Draw black text
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0, 0, 0, 1));
-        ImGui::SetWindowFontScale(6.0f);
-        ImGui::TextUnformatted(statsText.c_str());
+        ImGui::SetWindowFontScale(lay.statsFontScale);
+        ImGui::TextUnformatted(statsText.text);
         ImGui::PopStyleColor();
 
         ImGui::PopFont();
@@ -469,42 +476,14 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
     // ========================================================================
     else
     {
-        // --------------------------------------------------------------------
-        // TIMER UPDATE LOGIC
-        // --------------------------------------------------------------------
-     
-        if (!timerInitialized) {
-            currentRound = 1;
-            currentState = TIMER_FOCUS;
-            countdownSeconds = 25 * 60;
-            lastTick = ImGui::GetTime();
-            timerInitialized = true;
-        }
-
-        // Update countdown every second when timer is running
-        double currentTime = ImGui::GetTime();
-        if (startButtonState && (currentTime - lastTick) >= 1.0) {
-            if (countdownSeconds > 0) {
-               
-                countdownSeconds--;
-            }
-            else {
-               
-           
-                AdvanceToNextSession(audiofiles);
-
-            }
-            lastTick = currentTime;
-        }
-
         // --------------------------------------------------------------------
         // FORMAT TIMER DISPLAY
         // --------------------------------------------------------------------
-        // Convert seconds to MM:SS format
-        int minutes = countdownSeconds / 60;
-        int seconds = countdownSeconds % 60;
-        char timerText[16];
-        sprintf_s(timerText, sizeof(timerText), "%02d:%02d", minutes, seconds);
+        // Session changes run on the timer wheel; this only reads the
+        // remaining time off the deadline. Convert seconds to MM:SS format
+        int remaining = Timer_DisplaySeconds(countdown, std::chrono::steady_clock::now());
+        int minutes = remaining / 60;
+        int seconds = remaining % 60;
 
         // Determine what type of session we're in
         const char* sessionLabel = "";
@@ -538,34 +517,36 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
             ImGuiWindowFlags_NoSavedSettings);
 
         // Draw session label 
-        ImGui::SetWindowFontScale(6.5f);
+        ImGui::SetWindowFontScale(lay.sessionLabelFontScale);
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0, 0, 0, 1));  
 
-        char labelText[64];
+        const CachedLabel* labelText = nullptr;
+        uint64_t labelKey = Label_Key(currentState, currentRound);
         if (currentState == TIMER_FOCUS) {
-            sprintf_s(labelText, sizeof(labelText), "%s %d", sessionLabel, currentRound);
+            labelText = &Label_Update(sessionLabelText, labelKey, "%s %d", sessionLabel, currentRound);
         }
         else if (currentState == SESSION_ENDED) {
-            sprintf_s(labelText, sizeof(labelText), "%s!", sessionLabel);
+            labelText = &Label_Update(sessionLabelText, labelKey, "%s!", sessionLabel);
         }
         else {
-            sprintf_s(labelText, sizeof(labelText), "%s", sessionLabel);
+            labelText = &Label_Update(sessionLabelText, labelKey, "%s", sessionLabel);
         }
 
         // Calculate label position 
-        ImVec2 labelSize = ImGui::CalcTextSize(labelText);
+        ImVec2 labelSize = labelText->size;
         float labelX = (io.DisplaySize.x - labelSize.x) * 0.5f;
-        float labelY = (io.DisplaySize.y * 0.5f) - 150.0f;
-        ImGui::SetCursorPos(ImVec2(labelX, labelY));
-        ImGui::TextUnformatted(labelText);
+        ImGui::SetCursorPos(ImVec2(labelX, lay.sessionLabelY));
+        ImGui::TextUnformatted(labelText->text);
 
         // Draw timer 
-        ImGui::SetWindowFontScale(8.0f);
-        ImVec2 timerSize = ImGui::CalcTextSize(timerText);
+        ImGui::SetWindowFontScale(lay.timerFontScale);
+        const CachedLabel& timerText = Label_Update(timerLabel,
+            Label_Key(minutes, seconds), "%02d:%02d", minutes, seconds);
+        ImVec2 timerSize = timerText.size;
         float timerX = (io.DisplaySize.x - timerSize.x) * 0.5f;
         float timerY = (io.DisplaySize.y - timerSize.y) * 0.5f;
         ImGui::SetCursorPos(ImVec2(timerX, timerY));
-        ImGui::Text("%s", timerText);
+        ImGui::TextUnformatted(timerText.text);
       
 
         ImGui::PopStyleColor();
@@ -576,80 +557,47 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
     // BOTTOM CONTROL BUTTONS 
     // ========================================================================
 
-    // Get texture IDs for each button
-    // NOTE: Textures are swapped - stop icon is used for reset and vice versa
-    GLuint stopTexture = textures.size() > 7 ? textures[7] : 0;      // Reset icon
-    GLuint resetTexture = textures.size() > 5 ? textures[5] : 0;     // Stop icon
+    // Atlas regions for each button (all share the same atlas texture)
+    // NOTE: Icons are swapped - stop icon is used for reset and vice versa
+    const AtlasRegion& stopIcon = Atlas_Get(ICON_RESET);     // Reset icon
+    const AtlasRegion& resetIcon = Atlas_Get(ICON_STOP);     // Stop icon
 
     // Start button changes image based on state (play vs pause)
-    GLuint startTexture = 0;
-    if (startButtonState) {
-        startTexture = textures.size() > 6 ? textures[6] : 0;  // Pause icon
-    }
-    else {
-        startTexture = textures.size() > 4 ? textures[4] : 0;  // Play icon
-    }
-
-    // Get raw texture sizes
-    ImVec2 stopRawSize = GetRawTexSize(stopTexture);
-    ImVec2 startRawSize = GetRawTexSize(startTexture);
-    ImVec2 resetRawSize = GetRawTexSize(resetTexture);
-
-    // Default size if texture is invalid
-    if (stopRawSize.x <= 0) stopRawSize = ImVec2(120, 120);
-    if (startRawSize.x <= 0) startRawSize = ImVec2(120, 120);
-    if (resetRawSize.x <= 0) resetRawSize = ImVec2(120, 120);
+    const AtlasRegion& startIcon = Atlas_Get(startButtonState ? ICON_PAUSE : ICON_START);
 
-    // Apply scaling to each button
-    ImVec2 stopImageSize = ImVec2(stopRawSize.x * stopScale, stopRawSize.y * stopScale);
-    ImVec2 startImageSize = ImVec2(startRawSize.x * startScale, startRawSize.y * startScale);
-    ImVec2 resetImageSize = ImVec2(resetRawSize.x * resetScale, resetRawSize.y * resetScale);
-
-    // Add padding around each button
-    float padding = 6.0f;
-    ImVec2 stopWindowSize = ImVec2(stopImageSize.x + padding * 2, stopImageSize.y + padding * 2);
-    ImVec2 startWindowSize = ImVec2(startImageSize.x + padding * 2, startImageSize.y + padding * 2);
-    ImVec2 resetWindowSize = ImVec2(resetImageSize.x + padding * 2, resetImageSize.y + padding * 2);
-
-    // Calculate button positions (centered at bottom of screen)
-    const float buttonSpacing = 28.0f;
-    float centerX = io.DisplaySize.x * 0.5f;
-    float baseY = io.DisplaySize.y - std::max({ stopWindowSize.y, startWindowSize.y, resetWindowSize.y }) - 30.0f;
-
-    // Start button is in center
-    float startX = centerX - startWindowSize.x * 0.5f + startOffset.x;
-    float startY = baseY + startOffset.y;
-
-    // Stop button is to the left
-    float stopX = startX - buttonSpacing - stopWindowSize.x + stopOffset.x;
-    float stopY = baseY + stopOffset.y;
-
-    // Reset button is to the right
-    float resetX = startX + startWindowSize.x + buttonSpacing + resetOffset.x;
-    float resetY = baseY + resetOffset.y;
+    // Start shares its slot with pause; the layout centers either image in it
+    const LayoutButton& startButton = startButtonState ? lay.pause : lay.start;
 
     // ------------------------------------------------------------------------
-    // (left button - resets everything and returns to logo)
+    // CONTROL BAR WINDOW
+    // All three buttons live in one window (one draw list) and sample the
+    // same atlas texture, so ImGui can merge them into a single draw call.
     // ------------------------------------------------------------------------
-    ImGui::SetNextWindowPos(ImVec2(stopX, stopY));
-    ImGui::SetNextWindowSize(stopWindowSize);
+    ImGui::SetNextWindowPos(lay.controlBar.pos);
+    ImGui::SetNextWindowSize(lay.controlBar.size);
 
-    ImGui::Begin("StopBtnWindow1", nullptr,
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
+    ImGui::Begin("ControlBar1", nullptr,
         ImGuiWindowFlags_NoDecoration |
-        ImGuiWindowFlags_NoBackground);
-
-    // Transparent button with subtle hover effect
+        ImGuiWindowFlags_NoBackground |
+        ImGuiWindowFlags_NoMove |
+        ImGuiWindowFlags_NoResize |
+        ImGuiWindowFlags_NoScrollbar |
+        ImGuiWindowFlags_NoScrollWithMouse |
+        ImGuiWindowFlags_NoSavedSettings);
+
+    // Transparent buttons with subtle hover effect
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1, 1, 1, 0.1f));
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(1, 1, 1, 0.2f));
 
-    // Center image in window
-    ImGui::SetCursorPos(ImVec2(
-        (stopWindowSize.x - stopImageSize.x) * 0.5f,
-        (stopWindowSize.y - stopImageSize.y) * 0.5f
-    ));
+    // ------------------------------------------------------------------------
+    // (left button - resets everything and returns to logo)
+    // ------------------------------------------------------------------------
+    ImGui::SetCursorPos(lay.stop.cursor);
 
-    if (ImGui::ImageButton("##StopButton", (ImTextureID)(intptr_t)stopTexture, stopImageSize))
+    if (ImGui::ImageButton("##StopButton", (ImTextureID)(intptr_t)stopIcon.texture, lay.stop.image,
+        stopIcon.uv0, stopIcon.uv1))
     {
         std::cout << "STOP/RESET BUTTON CLICKED\n";
 
@@ -661,54 +609,38 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
         pom.focusTime = 25;
         pom.shortBreak = 5;
         pom.longBreak = 0;  // 0 because rounds = 1 (< 4)
+        SettingsStore_MarkDirty(SETTINGS_POMODORO);
 
         // Reset timer state
         currentRound = 1;
         currentState = TIMER_FOCUS;
-        countdownSeconds = pom.focusTime * 60;
+        Timer_Set(countdown, std::chrono::minutes(pom.focusTime));
         timerInitialized = false;
-        lastTick = ImGui::GetTime();
 
         // Return to logo screen
         resumeButtonstate = true;
+        ScheduleSessionEnd(audiofiles);
         //
-        Audio_StopChannel(ch1);
+        Ambient_Pause();
         ch1playing = 0;
-        ch1 = -1;
     }
 
-    ImGui::PopStyleColor(3);
-    ImGui::End();
-
     // ------------------------------------------------------------------------
     // START/PAUSE BUTTON 
     // ------------------------------------------------------------------------
-    ImGui::SetNextWindowPos(ImVec2(startX, startY));
-    ImGui::SetNextWindowSize(startWindowSize);
-
-    ImGui::Begin("StartBtnWindow1", nullptr,
-        ImGuiWindowFlags_NoDecoration |
-        ImGuiWindowFlags_NoBackground);
-
-    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
-    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1, 1, 1, 0.1f));
-    ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(1, 1, 1, 0.2f));
+    ImGui::SetCursorPos(startButton.cursor);
 
-    ImGui::SetCursorPos(ImVec2(
-        (startWindowSize.x - startImageSize.x) * 0.5f,
-        (startWindowSize.y - startImageSize.y) * 0.5f
-    ));
-
-    if (ImGui::ImageButton("##StartButton", (ImTextureID)(intptr_t)startTexture, startImageSize))
+    if (ImGui::ImageButton("##StartButton", (ImTextureID)(intptr_t)startIcon.texture, startButton.image,
+        startIcon.uv0, startIcon.uv1))
     {
         // If on logo screen, enter timer screen and start playing
         if (resumeButtonstate) {
             resumeButtonstate = false;
             timerInitialized = false;  // Will be initialized on next frame
             startButtonState = true;   // Start playing immediately
-            if (ch1 == -1)
+            if (!Ambient_IsPlaying())
             {
-                ch1 = Audio_PlayOnce(audiofiles[0]);
+                Ambient_Play();
                 ch1playing = 1;
             }
            
@@ -716,14 +648,21 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
         else {
             // If on timer screen, toggle play/pause
             startButtonState = !startButtonState;
+            if (startButtonState) {
+                Timer_Resume(countdown, std::chrono::steady_clock::now());
+            }
+            else {
+                Timer_Pause(countdown, std::chrono::steady_clock::now());
+            }
+            ScheduleSessionEnd(audiofiles);
             if (ch1playing == 1)
             {
-                Audio_PauseChannel(ch1);
+                Ambient_Pause();
                 ch1playing = 0;
             }
             else
             {
-                Audio_ResumeChannel(ch1);
+                Ambient_Play();
                 ch1playing = 1;
             }
             
@@ -732,29 +671,13 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
         std::cout << "START BUTTON CLICKED -> Playing = " << (startButtonState ? "YES" : "NO") << "\n";
     }
 
-    ImGui::PopStyleColor(3);
-    ImGui::End();
-
     // ------------------------------------------------------------------------
     // RESET/RESUME BUTTON (right button - returns to logo screen)
     // ------------------------------------------------------------------------
-    ImGui::SetNextWindowPos(ImVec2(resetX, resetY));
-    ImGui::SetNextWindowSize(resetWindowSize);
-
-    ImGui::Begin("ResetBtnWindow1", nullptr,
-        ImGuiWindowFlags_NoDecoration |
-        ImGuiWindowFlags_NoBackground);
-
-    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
-    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1, 1, 1, 0.1f));
-    ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(1, 1, 1, 0.2f));
-
-    ImGui::SetCursorPos(ImVec2(
-        (resetWindowSize.x - resetImageSize.x) * 0.5f,
-        (resetWindowSize.y - resetImageSize.y) * 0.5f
-    ));
+    ImGui::SetCursorPos(lay.reset.cursor);
 
-    if (ImGui::ImageButton("##ResetButton", (ImTextureID)(intptr_t)resetTexture, resetImageSize))
+    if (ImGui::ImageButton("##ResetButton", (ImTextureID)(intptr_t)resetIcon.texture, lay.reset.image,
+        resetIcon.uv0, resetIcon.uv1))
     {
         std::cout << "RESUME BUTTON CLICKED\n";
 
@@ -764,16 +687,18 @@ void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont, st
         // Reset timer initialization flag
         timerInitialized = false;
 
-        Audio_StopChannel(ch1);
+        Ambient_Pause();
         ch1playing = 0;
-        ch1 = -1;
 
         // Toggle start button if it was running
         if (startButtonState) {
             startButtonState = !startButtonState;
         }
+        Timer_Pause(countdown, std::chrono::steady_clock::now());
+        ScheduleSessionEnd(audiofiles);
     }
 
     ImGui::PopStyleColor(3);
     ImGui::End();
+    ImGui::PopStyleVar();
 }
@@ -32,3 +32,8 @@
 void PomederoTab(ImGuiIO& io, std::vector<GLuint>& textures, ImFont* bigFont , std::vector<Mix_Chunk*> audiofiles);
 ImVec2 GetScaledSizeFromGLTexture(GLuint glTex, const ImVec2& maxBox);
 ImVec2 GetRawTexSize(GLuint tex);
+
+// When the idle main loop must wake up next to redraw the countdown (each
+// visible second while it is on screen; time_point::max() otherwise).
+// Session changes are scheduled on the timer wheel.
+std::chrono::steady_clock::time_point Pomodoro_NextWake(bool countdownVisible);
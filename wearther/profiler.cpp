@@ -0,0 +1,297 @@
+// ============================================================================
+// Frame-Phase Profiler
+// ============================================================================
+// CPU timers per main-loop phase plus a GL_TIME_ELAPSED query around the
+// draw, kept in a fixed ring buffer. The overlay shows p50/p99 and the CSV
+// export lets two builds be compared offline.
+
+#include "profiler.h"
+
+#include <glad/glad.h>
+#include "imgui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+static constexpr int HISTORY_FRAMES = 600;     // ~10 s at 60 Hz
+static constexpr int GPU_QUERY_COUNT = 4;      // frames in flight before reuse
+
+static const char* PHASE_NAMES[PHASE_COUNT] = {
+    "events", "tabs", "imgui_render", "gl_draw", "swap"
+};
+
+struct FrameSample {
+    float phaseMs[PHASE_COUNT];
+    float frameMs;
+    float gpuMs;        // < 0 until the query result arrives
+    bool background;    // background work was running during the frame
+};
+
+static FrameSample history[HISTORY_FRAMES];
+static long long framesRecorded = 0;           // total frames ever recorded
+
+static FrameSample currentFrame;
+static Uint64 frameStart = 0;
+static double ticksToMs = 0.0;
+
+// GPU timer queries, reused round-robin
+static GLuint gpuQueries[GPU_QUERY_COUNT] = {};
+static long long gpuQueryFrame[GPU_QUERY_COUNT];   // frame that owns the query, -1 = free
+static bool gpuQueryActive = false;
+
+static bool overlayVisible = false;
+
+// Scratch for percentiles (no per-frame allocation)
+static float sortScratch[HISTORY_FRAMES];
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static int RecordedCount()
+{
+    return (int)std::min<long long>(framesRecorded, HISTORY_FRAMES);
+}
+
+// Oldest-first access into the ring buffer
+static const FrameSample& SampleAt(int i)
+{
+    long long first = framesRecorded - RecordedCount();
+    return history[(first + i) % HISTORY_FRAMES];
+}
+
+// ----------------------------------------------------------------------------
+// Percentile of one float field over the recorded frames (p in 0..1)
+// ----------------------------------------------------------------------------
+template <typename Getter>
+static float Percentile(Getter get, float p)
+{
+    int n = 0;
+    for (int i = 0; i < RecordedCount(); ++i) {
+        float v = get(SampleAt(i));
+        if (v >= 0.0f) sortScratch[n++] = v;
+    }
+    if (n == 0) return 0.0f;
+
+    int k = std::min(n - 1, (int)(p * (n - 1) + 0.5f));
+    std::nth_element(sortScratch, sortScratch + k, sortScratch + n);
+    return sortScratch[k];
+}
+
+// ----------------------------------------------------------------------------
+// Read back finished GPU queries without waiting on the driver
+// ----------------------------------------------------------------------------
+static void CollectGpuResults()
+{
+    for (int q = 0; q < GPU_QUERY_COUNT; ++q)
+    {
+        if (gpuQueryFrame[q] < 0) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(gpuQueries[q], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(gpuQueries[q], GL_QUERY_RESULT, &ns);
+
+        // Only store it if the frame is still in the ring
+        long long frame = gpuQueryFrame[q];
+        if (frame >= framesRecorded - HISTORY_FRAMES && frame < framesRecorded) {
+            history[frame % HISTORY_FRAMES].gpuMs = (float)(ns / 1.0e6);
+        }
+        gpuQueryFrame[q] = -1;
+    }
+}
+
+// ============================================================================
+// LIFETIME
+// ============================================================================
+void Profiler_Init()
+{
+    ticksToMs = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    glGenQueries(GPU_QUERY_COUNT, gpuQueries);
+    std::fill(gpuQueryFrame, gpuQueryFrame + GPU_QUERY_COUNT, -1LL);
+}
+
+void Profiler_Shutdown()
+{
+    glDeleteQueries(GPU_QUERY_COUNT, gpuQueries);
+}
+
+// ============================================================================
+// FRAME BRACKETS
+// ============================================================================
+void Profiler_BeginFrame()
+{
+    currentFrame = FrameSample{};
+    currentFrame.gpuMs = -1.0f;
+    frameStart = SDL_GetPerformanceCounter();
+}
+
+void Profiler_EndFrame()
+{
+    currentFrame.frameMs = (float)((SDL_GetPerformanceCounter() - frameStart) * ticksToMs);
+
+    history[framesRecorded % HISTORY_FRAMES] = currentFrame;
+    framesRecorded++;
+
+    CollectGpuResults();
+}
+
+void Profiler_MarkBackgroundWork(bool active)
+{
+    currentFrame.background = currentFrame.background || active;
+}
+
+void Profiler_BeginGpu()
+{
+    int slot = (int)(framesRecorded % GPU_QUERY_COUNT);
+
+    // Query still pending from an older frame: skip GPU timing this frame
+    // rather than stall on its result
+    gpuQueryActive = gpuQueries[slot] != 0 && gpuQueryFrame[slot] < 0;
+    if (gpuQueryActive) {
+        glBeginQuery(GL_TIME_ELAPSED, gpuQueries[slot]);
+    }
+}
+
+void Profiler_EndGpu()
+{
+    if (!gpuQueryActive) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    gpuQueryFrame[framesRecorded % GPU_QUERY_COUNT] = framesRecorded;
+    gpuQueryActive = false;
+}
+
+ProfileScope::ProfileScope(ProfilePhase p)
+    : phase(p), start(SDL_GetPerformanceCounter())
+{
+}
+
+ProfileScope::~ProfileScope()
+{
+    currentFrame.phaseMs[phase] += (float)((SDL_GetPerformanceCounter() - start) * ticksToMs);
+}
+
+// ============================================================================
+// INPUT
+// ============================================================================
+bool Profiler_HandleEvent(const SDL_Event& e)
+{
+    if (e.type != SDL_KEYDOWN || e.key.repeat) return false;
+
+    if (e.key.keysym.sym == SDLK_F3) {
+        overlayVisible = !overlayVisible;
+        return true;
+    }
+
+    if (e.key.keysym.sym == SDLK_F4) {
+        std::time_t t = std::time(nullptr);
+        std::tm local{};
+        localtime_s(&local, &t);
+
+        char path[64];
+        std::strftime(path, sizeof(path), "profile_%Y%m%d_%H%M%S.csv", &local);
+        Profiler_ExportCsv(path);
+        return true;
+    }
+
+    return false;
+}
+
+// ============================================================================
+// OVERLAY
+// ============================================================================
+void Profiler_DrawOverlay()
+{
+    if (!overlayVisible) return;
+
+    ImGui::SetNextWindowPos(ImVec2(10, 90), ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.75f);
+
+    ImGui::Begin("##Profiler", nullptr,
+        ImGuiWindowFlags_NoDecoration |
+        ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav |
+        ImGuiWindowFlags_NoInputs);
+
+    ImGui::SetWindowFontScale(1.0f);
+
+    auto frameMs = [](const FrameSample& s) { return s.frameMs; };
+    auto gpuMs = [](const FrameSample& s) { return s.gpuMs; };
+    auto busyMs = [](const FrameSample& s) { return s.background ? s.frameMs : -1.0f; };
+    auto quietMs = [](const FrameSample& s) { return s.background ? -1.0f : s.frameMs; };
+
+    ImGui::Text("Frames: %d", RecordedCount());
+    ImGui::Text("CPU frame  p50 %6.2f ms   p99 %6.2f ms",
+        Percentile(frameMs, 0.50f), Percentile(frameMs, 0.99f));
+    ImGui::Text("GPU draw   p50 %6.2f ms   p99 %6.2f ms",
+        Percentile(gpuMs, 0.50f), Percentile(gpuMs, 0.99f));
+    ImGui::Text("Idle bg    p50 %6.2f ms   p99 %6.2f ms",
+        Percentile(quietMs, 0.50f), Percentile(quietMs, 0.99f));
+    ImGui::Text("Busy bg    p50 %6.2f ms   p99 %6.2f ms",
+        Percentile(busyMs, 0.50f), Percentile(busyMs, 0.99f));
+
+    ImGui::Separator();
+
+    for (int p = 0; p < PHASE_COUNT; ++p)
+    {
+        auto phaseMs = [p](const FrameSample& s) { return s.phaseMs[p]; };
+        ImGui::Text("%-13s p50 %6.2f ms   p99 %6.2f ms", PHASE_NAMES[p],
+            Percentile(phaseMs, 0.50f), Percentile(phaseMs, 0.99f));
+    }
+
+    // Oldest-first view of the ring for the graph
+    int count = RecordedCount();
+    int offset = (int)((framesRecorded - count) % HISTORY_FRAMES);
+    ImGui::PlotLines("##FrameTimes", &history[0].frameMs, count, offset,
+        "CPU frame ms", 0.0f, FLT_MAX, ImVec2(360, 60), sizeof(FrameSample));
+
+    ImGui::TextDisabled("F3 hide   F4 export CSV");
+    ImGui::End();
+}
+
+// ============================================================================
+// CSV EXPORT
+// ============================================================================
+bool Profiler_ExportCsv(const char* path)
+{
+    FILE* f = nullptr;
+    if (fopen_s(&f, path, "w") != 0 || !f) {
+        std::cerr << "[Profiler] Failed to open " << path << "\n";
+        return false;
+    }
+
+    std::fprintf(f, "frame,frame_ms");
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        std::fprintf(f, ",%s_ms", PHASE_NAMES[p]);
+    }
+    std::fprintf(f, ",gpu_ms,background\n");
+
+    long long first = framesRecorded - RecordedCount();
+    for (int i = 0; i < RecordedCount(); ++i)
+    {
+        const FrameSample& s = SampleAt(i);
+        std::fprintf(f, "%lld,%.4f", first + i, s.frameMs);
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            std::fprintf(f, ",%.4f", s.phaseMs[p]);
+        }
+        if (s.gpuMs >= 0.0f) std::fprintf(f, ",%.4f", s.gpuMs);
+        else std::fprintf(f, ",");
+        std::fprintf(f, ",%d\n", s.background ? 1 : 0);
+    }
+
+    std::fclose(f);
+    std::cout << "[Profiler] Wrote " << RecordedCount() << " frames to " << path << "\n";
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <SDL.h>
+
+// Main-loop phases timed on the CPU every frame
+enum ProfilePhase {
+    PHASE_EVENTS,           // SDL_PollEvent + ImGui event processing
+    PHASE_TABS,             // NewFrame + tab functions + tab bar
+    PHASE_IMGUI_RENDER,     // ImGui::Render
+    PHASE_GL_DRAW,          // ImGui_ImplOpenGL3_RenderDrawData
+    PHASE_SWAP,             // SDL_GL_SwapWindow
+    PHASE_COUNT
+};
+
+// Call once after the GL context exists / before it is destroyed
+void Profiler_Init();
+void Profiler_Shutdown();
+
+// Bracket one frame (excluding any idle wait)
+void Profiler_BeginFrame();
+void Profiler_EndFrame();
+
+// Flag the current frame as overlapping background work (e.g. a weather
+// refresh), so its cost on frame times can be compared with idle frames
+void Profiler_MarkBackgroundWork(bool active);
+
+// Bracket the GL draw with a GL_TIME_ELAPSED query (results read back
+// a few frames later, never stalling the pipeline)
+void Profiler_BeginGpu();
+void Profiler_EndGpu();
+
+// Adds the scope's duration to the current frame's phase
+struct ProfileScope {
+    explicit ProfileScope(ProfilePhase phase);
+    ~ProfileScope();
+
+    ProfilePhase phase;
+    Uint64 start;
+};
+
+// F3 toggles the overlay, F4 writes the history to a CSV file.
+// Returns true if the event was consumed.
+bool Profiler_HandleEvent(const SDL_Event& e);
+
+// Draw the overlay (inside an ImGui frame) if it is enabled
+void Profiler_DrawOverlay();
+
+// Write every recorded frame still in the ring buffer
+bool Profiler_ExportCsv(const char* path);
@@ -0,0 +1,175 @@
+// ============================================================================
+// Weather Replay Server
+// ============================================================================
+// An in-process httplib::Server answering the two endpoints the app uses.
+// Latency and failures are injected per request so refresh timing and the
+// retry path can be measured without touching the real services.
+
+#include "replayServer.h"
+#include "httplib.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+static std::unique_ptr<httplib::Server> server;
+static std::thread serverThread;
+
+static ReplayConfig config;
+static std::string geoBody;
+static std::string forecastBody;
+
+static std::mutex rngMutex;
+static std::mt19937 rng{ 12345 };      // fixed seed: runs are repeatable
+
+// ============================================================================
+// RECORDED RESPONSES
+// ============================================================================
+
+static bool ReadText(const std::string& path, std::string& out)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !out.empty();
+}
+
+static std::string SampleGeo()
+{
+    return R"({"status":"success","lat":52.52,"lon":13.405,)"
+        R"("city":"Replay City","timezone":"Europe/Berlin"})";
+}
+
+// ----------------------------------------------------------------------------
+// A week of plausible hourly data, same shape as a real Open-Meteo answer
+// ----------------------------------------------------------------------------
+static std::string SampleForecast()
+{
+    static constexpr int HOURS = 7 * 24;
+    static const int CODES[] = { 0, 1, 2, 3, 61, 63, 95 };
+
+    std::ostringstream time, temp, wind, humidity, code;
+    for (int h = 0; h < HOURS; ++h)
+    {
+        const char* sep = h ? "," : "";
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "\"2024-05-%02dT%02d:00\"", 1 + h / 24, h % 24);
+
+        int hourOfDay = h % 24;
+        double t = 14.0 + 6.0 * (hourOfDay >= 6 && hourOfDay <= 15
+            ? (hourOfDay - 6) / 9.0 : hourOfDay > 15 ? (24 - hourOfDay) / 9.0 : 0.0);
+
+        time << sep << stamp;
+        temp << sep << t;
+        wind << sep << 5 + (h * 7) % 13;
+        humidity << sep << 55 + (h * 5) % 30;
+        code << sep << CODES[(h / 6) % 7];
+    }
+
+    std::ostringstream body;
+    body << R"({"latitude":52.52,"longitude":13.41,"timezone":"Europe/Berlin",)"
+        << R"("current_weather_units":{"temperature":"C","windspeed":"km/h"},)"
+        << R"("current_weather":{"time":"2024-05-01T12:00","temperature":18.2,)"
+        << R"("windspeed":9.4,"winddirection":240,"weathercode":2,"is_day":1},)"
+        << R"("hourly_units":{"time":"iso8601"},)"
+        << R"("hourly":{"time":[)" << time.str()
+        << R"(],"temperature_2m":[)" << temp.str()
+        << R"(],"wind_speed_10m":[)" << wind.str()
+        << R"(],"relative_humidity_2m":[)" << humidity.str()
+        << R"(],"weathercode":[)" << code.str() << "]}}";
+    return body.str();
+}
+
+// ----------------------------------------------------------------------------
+// Sleep for the configured latency; true if this request should fail
+// ----------------------------------------------------------------------------
+static bool InjectFaults()
+{
+    int delay = config.latencyMs;
+    bool fail = false;
+    {
+        std::lock_guard<std::mutex> lock(rngMutex);
+        if (config.jitterMs > 0) {
+            delay += std::uniform_int_distribution<int>(0, config.jitterMs)(rng);
+        }
+        if (config.failureRate > 0.0) {
+            fail = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < config.failureRate;
+        }
+    }
+
+    if (delay > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    }
+    return fail;
+}
+
+static void Serve(const std::string& body, httplib::Response& res)
+{
+    if (InjectFaults()) {
+        res.status = 503;
+        res.set_content("injected failure", "text/plain");
+        return;
+    }
+    res.set_content(body, "application/json");
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+std::string ReplayServer_Start(const ReplayConfig& cfg)
+{
+    if (server) return {};
+
+    config = cfg;
+    if (!ReadText(config.directory + "/geo.json", geoBody)) geoBody = SampleGeo();
+    forecastBody = ReplayServer_ForecastBody(config.directory);
+
+    server = std::make_unique<httplib::Server>();
+    server->Get("/json", [](const httplib::Request&, httplib::Response& res) {
+        Serve(geoBody, res);
+    });
+    server->Get("/v1/forecast", [](const httplib::Request&, httplib::Response& res) {
+        Serve(forecastBody, res);
+    });
+
+    int port = server->bind_to_any_port("127.0.0.1");
+    if (port <= 0) {
+        std::cerr << "[Replay] Failed to bind a local port\n";
+        server.reset();
+        return {};
+    }
+
+    serverThread = std::thread([] { server->listen_after_bind(); });
+
+    std::cout << "[Replay] Serving on 127.0.0.1:" << port
+        << " (latency " << config.latencyMs << "+" << config.jitterMs << " ms, failure rate "
+        << config.failureRate << ")\n";
+    return "http://127.0.0.1:" + std::to_string(port);
+}
+
+void ReplayServer_Stop()
+{
+    if (!server) return;
+
+    server->stop();
+    if (serverThread.joinable()) serverThread.join();
+    server.reset();
+}
+
+std::string ReplayServer_ForecastBody(const std::string& directory)
+{
+    std::string body;
+    if (!ReadText(directory + "/forecast.json", body)) body = SampleForecast();
+    return body;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+// Local stand-in for ip-api.com and api.open-meteo.com. Serves recorded
+// responses from `directory` (geo.json, forecast.json) or built-in samples
+// when those files are missing, so the fetch path can be load-tested offline.
+struct ReplayConfig
+{
+    std::string directory = "replay";
+    int latencyMs = 0;              // added before every response
+    int jitterMs = 0;               // + uniform 0..jitterMs
+    double failureRate = 0.0;       // 0..1, fraction answered with HTTP 503
+};
+
+// Start serving on 127.0.0.1 (any free port). Returns the base URL to use as
+// a host, e.g. "http://127.0.0.1:51234", or an empty string on failure.
+std::string ReplayServer_Start(const ReplayConfig& config);
+void ReplayServer_Stop();
+
+// The forecast body the server would answer with: `directory`/forecast.json
+// if present, the built-in sample otherwise (benchmarks use this directly)
+std::string ReplayServer_ForecastBody(const std::string& directory);
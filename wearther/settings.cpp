@@ -10,12 +10,11 @@
 #include "imgui_impl_sdl2.h"
 #include "imgui_impl_opengl3.h"
 #include "audio.h"
+#include "ambientStream.h"
+#include "settingsStore.h"
+#include "layout.h"
 
-// Layout constants
-static constexpr float TOGGLE_WIDTH = 50.0f;
-static constexpr float SLIDER_WIDTH = 300.0f;
-static constexpr float CONTROL_HEIGHT = 26.0f;
-static constexpr float LABEL_OFFSET_X = 240.0f;
+// Control sizes scale with the window (SettingsLayout in layout.cpp)
 
 // ============================================================================
 // TOGGLE (BLACK WHEN ON)
@@ -28,13 +27,14 @@ void GlassToggle(const char* id, const char* label, bool* value)
     ImGui::Text("%s", label);
     ImGui::PopStyleColor();
 
-    ImGui::SameLine(LABEL_OFFSET_X);
+    ImGui::SameLine(Layout_Get().settings.labelOffsetX);
 
     ImVec2 pos = ImGui::GetCursorScreenPos();
     ImDrawList* dl = ImGui::GetWindowDrawList();
 
-    float h = CONTROL_HEIGHT;
-    float w = TOGGLE_WIDTH;
+    const SettingsLayout& lay = Layout_Get().settings;
+    float h = lay.controlHeight;
+    float w = lay.toggleWidth;
     float r = h * 0.5f;
 
     ImGui::InvisibleButton("toggle", ImVec2(w, h));
@@ -95,13 +95,14 @@ void GlassSliderFloat(
     ImGui::Text("%s", label);
     ImGui::PopStyleColor();
 
-    ImGui::SameLine(LABEL_OFFSET_X);
+    ImGui::SameLine(Layout_Get().settings.labelOffsetX);
 
     ImVec2 pos = ImGui::GetCursorScreenPos();
     ImDrawList* dl = ImGui::GetWindowDrawList();
 
-    float w = SLIDER_WIDTH;
-    float h = CONTROL_HEIGHT;
+    const SettingsLayout& lay = Layout_Get().settings;
+    float w = lay.sliderWidth;
+    float h = lay.controlHeight;
     float r = h * 0.5f;
 
     ImGui::InvisibleButton("slider", ImVec2(w, h));
@@ -111,15 +112,14 @@ void GlassSliderFloat(
         float t = (ImGui::GetIO().MousePos.x - pos.x) / w;
         t = t < 0 ? 0 : (t > 1 ? 1 : t);
         *value = min + (max - min) * t;
+
+        // Live while dragging: just an atomic store, ramped in the callback
+        Audio_SetVolume(*value);
     }
 
     if (ImGui::IsItemDeactivated())
     {
         std::cout << label << ": " << *value << std::endl;
-        int x = *value * 100;
-        Audio_SetAllChannelVolume(x);
-        std::cout << "volume changed";
-        
     }
 
     float t = (*value - min) / (max - min);
@@ -201,7 +201,7 @@ void GlassCombo(
     ImGui::Text("%s", label);
     ImGui::PopStyleColor();
 
-    ImGui::SameLine(LABEL_OFFSET_X);
+    ImGui::SameLine(Layout_Get().settings.labelOffsetX);
 
     ImGui::PushStyleColor(ImGuiCol_FrameBg, IM_COL32(220, 220, 220, 255));
     ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, IM_COL32(200, 200, 200, 255));
@@ -215,12 +215,13 @@ void GlassCombo(
     ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 0, 0, 255));
     ImGui::PushStyleColor(ImGuiCol_PopupBg, IM_COL32(240, 240, 240, 255));
 
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, CONTROL_HEIGHT * 0.5f);
-    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(14, 5));
-    ImGui::PushStyleVar(ImGuiStyleVar_PopupRounding, 8.0f);
+    const SettingsLayout& lay = Layout_Get().settings;
+    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, lay.controlHeight * 0.5f);
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, lay.comboPadding);
+    ImGui::PushStyleVar(ImGuiStyleVar_PopupRounding, lay.popupRounding);
     ImGui::PushStyleVar(ImGuiStyleVar_PopupBorderSize, 0.0f);
 
-    ImGui::SetNextItemWidth(200);
+    ImGui::SetNextItemWidth(lay.comboWidth);
 
     int oldSelection = *current;
     if (ImGui::BeginCombo("##combo", items[*current]))
@@ -265,7 +266,7 @@ void Settingtab(
     ImGuiIO& io,
     std::vector<GLuint>& textures,
     ImFont* bigFont,
-    std::vector<Mix_Chunk*> audiofiles
+    std::vector<Mix_Chunk*>     // audiofiles: not used by this tab
 )
 {
     // Background
@@ -293,9 +294,10 @@ void Settingtab(
     ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0.0f);
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
 
-    ImVec2 center(io.DisplaySize.x * 0.5f, io.DisplaySize.y * 0.5f);
-    ImGui::SetNextWindowPos(ImVec2(center.x - 320, center.y - 180));
-    ImGui::SetNextWindowSize(ImVec2(640, 360));
+    // Recomputed on resize only
+    const SettingsLayout& lay = Layout_Get().settings;
+    ImGui::SetNextWindowPos(lay.panel.pos);
+    ImGui::SetNextWindowSize(lay.panel.size);
 
     ImGui::Begin("SettingsPanel", nullptr,
         ImGuiWindowFlags_NoDecoration |
@@ -303,6 +305,8 @@ void Settingtab(
         ImGuiWindowFlags_NoMove |
         ImGuiWindowFlags_NoResize);
 
+    ImGui::SetWindowFontScale(lay.fontScale);
+
     // Heading
     ImGui::PushFont(bigFont);
     ImGui::SetCursorPosX(
@@ -311,21 +315,31 @@ void Settingtab(
     ImGui::Text("SETTINGS");
     ImGui::PopFont();
 
-    ImGui::Dummy(ImVec2(0, 35));
+    ImGui::Dummy(ImVec2(0, lay.headingGap));
 
-    static bool  rainEnabled = true;
-    static float rainVolume = 1.0f;
-    static int   rainPreset = 0;
+    // Persisted; the store writes them out once they stop changing
+    SoundSettings& sound = SettingsStore_Get().sound;
+    SoundSettings before = sound;
 
     const char* presets[] = { "rain", "wave", "wind" };
+    if (sound.preset >= IM_ARRAYSIZE(presets)) sound.preset = 0;
 
-    GlassToggle("rain_toggle", "Sound", &rainEnabled);
-    ImGui::Dummy(ImVec2(0, 24));
+    GlassToggle("rain_toggle", "Sound", &sound.enabled);
+    ImGui::Dummy(ImVec2(0, lay.rowGap));
 
-    GlassSliderFloat("System Volume", "Rain Volume", &rainVolume, 0.0f, 1.0f);
-    ImGui::Dummy(ImVec2(0, 24));
+    GlassSliderFloat("System Volume", "Rain Volume", &sound.volume, 0.0f, 1.0f);
+    ImGui::Dummy(ImVec2(0, lay.rowGap));
 
-    GlassCombo("Voice List", presets, 3, &rainPreset);
+    // Crossfades on the audio thread; this only publishes the choice
+    GlassCombo("Voice List", presets, IM_ARRAYSIZE(presets), &sound.preset);
+    if (sound.preset != before.preset) {
+        Ambient_SelectPreset(sound.preset);
+    }
+
+    if (sound.enabled != before.enabled || sound.volume != before.volume ||
+        sound.preset != before.preset) {
+        SettingsStore_MarkDirty(SETTINGS_SOUND);
+    }
 
     ImGui::End();
     ImGui::PopStyleVar(2);
@@ -0,0 +1,192 @@
+// ============================================================================
+// Persistent Settings Store
+// ============================================================================
+// settings.ini is plain "section.key=value" lines. The UI thread only copies
+// the struct into `pending` under a mutex; the writer thread waits until no
+// change has arrived for DEBOUNCE_MS, then writes that copy.
+
+#include "settingsStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+static const char* SETTINGS_FILE = "settings.ini";
+
+// Long enough to cover a slider drag, short enough to survive a quick exit
+static constexpr int DEBOUNCE_MS = 500;
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+static AppSettings live;                // UI thread
+
+static std::thread writer;
+static std::mutex pendingMutex;
+static std::condition_variable pendingCv;
+static AppSettings pending;              // latest copy to write
+static uint32_t pendingFields = 0;      // dirty since the last write
+static std::chrono::steady_clock::time_point lastChange;
+static bool stopRequested = false;
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+static std::string Serialize(const AppSettings& s)
+{
+    std::ostringstream out;
+    out << "sound.enabled=" << (s.sound.enabled ? 1 : 0) << "\n";
+    out << "sound.volume=" << s.sound.volume << "\n";
+    out << "sound.preset=" << s.sound.preset << "\n";
+    out << "pomodoro.rounds=" << s.pomodoro.rounds << "\n";
+    out << "pomodoro.focusTime=" << s.pomodoro.focusTime << "\n";
+    out << "pomodoro.shortBreak=" << s.pomodoro.shortBreak << "\n";
+    out << "pomodoro.longBreak=" << s.pomodoro.longBreak << "\n";
+    out << "audio.chunkSize=" << s.audio.chunkSize << "\n";
+    return out.str();
+}
+
+static void ParseLine(AppSettings& s, const std::string& key, const std::string& value)
+{
+    try {
+        if (key == "sound.enabled") s.sound.enabled = std::stoi(value) != 0;
+        else if (key == "sound.volume") s.sound.volume = std::clamp(std::stof(value), 0.0f, 1.0f);
+        else if (key == "sound.preset") s.sound.preset = std::max(0, std::stoi(value));
+        else if (key == "pomodoro.rounds") s.pomodoro.rounds = std::max(1, std::stoi(value));
+        else if (key == "pomodoro.focusTime") s.pomodoro.focusTime = std::stoi(value);
+        else if (key == "pomodoro.shortBreak") s.pomodoro.shortBreak = std::stoi(value);
+        else if (key == "pomodoro.longBreak") s.pomodoro.longBreak = std::stoi(value);
+        else if (key == "audio.chunkSize") s.audio.chunkSize = std::max(0, std::stoi(value));
+    }
+    catch (const std::exception&) {
+        std::cerr << "[Settings] Ignoring bad value for " << key << "\n";
+    }
+}
+
+static void WriteFile(const AppSettings& s, uint32_t fields)
+{
+    std::string text = Serialize(s);
+
+    fs::path path = SETTINGS_FILE;
+    fs::path temp = path;
+    temp += ".tmp";
+
+    std::error_code ec;
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "[Settings] Failed to write " << temp.string() << "\n";
+            return;
+        }
+        file.write(text.data(), (std::streamsize)text.size());
+        if (!file) {
+            file.close();
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+
+    fs::rename(temp, path, ec);
+    if (ec) {
+        std::cerr << "[Settings] Failed to write " << SETTINGS_FILE << "\n";
+        fs::remove(temp, ec);
+        return;
+    }
+
+    std::cout << "[Settings] Saved"
+        << ((fields & SETTINGS_SOUND) ? " sound" : "")
+        << ((fields & SETTINGS_POMODORO) ? " pomodoro" : "")
+        << ((fields & SETTINGS_AUDIO) ? " audio" : "") << "\n";
+}
+
+// ============================================================================
+// WRITER THREAD
+// ============================================================================
+
+static void WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(pendingMutex);
+
+    while (true)
+    {
+        pendingCv.wait(lock, [] { return pendingFields != 0 || stopRequested; });
+
+        // Debounce: keep waiting while changes keep arriving
+        while (!stopRequested) {
+            auto due = lastChange + std::chrono::milliseconds(DEBOUNCE_MS);
+            if (std::chrono::steady_clock::now() >= due) break;
+            pendingCv.wait_until(lock, due);
+        }
+
+        if (pendingFields != 0) {
+            AppSettings copy = pending;
+            uint32_t fields = pendingFields;
+            pendingFields = 0;
+
+            lock.unlock();
+            WriteFile(copy, fields);
+            lock.lock();
+        }
+
+        if (stopRequested) return;
+    }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+void SettingsStore_Load()
+{
+    std::ifstream file(SETTINGS_FILE);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        ParseLine(live, line.substr(0, eq), line.substr(eq + 1));
+    }
+
+    if (writer.joinable()) return;
+    stopRequested = false;
+    writer = std::thread(WriterLoop);
+}
+
+AppSettings& SettingsStore_Get()
+{
+    return live;
+}
+
+void SettingsStore_MarkDirty(uint32_t fields)
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending = live;
+        pendingFields |= fields;
+        lastChange = std::chrono::steady_clock::now();
+    }
+    pendingCv.notify_one();
+}
+
+void SettingsStore_Shutdown()
+{
+    if (!writer.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        stopRequested = true;
+    }
+    pendingCv.notify_all();
+    writer.join();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+// Everything the user can change that should survive a restart. Loaded once
+// at startup; the UI thread edits the live struct directly and then marks
+// what it touched dirty. A background writer saves a copy once changes have
+// settled (write to a temp file, then rename), so dragging a slider never
+// does file I/O on the frame thread.
+
+struct SoundSettings
+{
+    bool enabled = true;
+    float volume = 1.0f;        // 0..1
+    int preset = 0;             // index into the ambient preset list
+};
+
+struct PomodoroSettings
+{
+    int rounds = 1;             // Number of rounds to complete
+    int focusTime = 25;         // Focus session duration (minutes)
+    int shortBreak = 5;         // Short break duration (minutes)
+    int longBreak = 0;          // Long break duration (minutes)
+};
+
+struct AudioDeviceSettings
+{
+    int chunkSize = 0;          // tuned buffer size, 0 = probe on next start
+};
+
+struct AppSettings
+{
+    SoundSettings sound;
+    PomodoroSettings pomodoro;
+    AudioDeviceSettings audio;
+};
+
+enum SettingsField : uint32_t {
+    SETTINGS_SOUND = 1u << 0,
+    SETTINGS_POMODORO = 1u << 1,
+    SETTINGS_AUDIO = 1u << 2,
+};
+
+// Reads settings.ini (missing or bad values keep their defaults) and starts
+// the writer. Call once, before anything reads the settings.
+void SettingsStore_Load();
+
+// The live settings (UI thread only)
+AppSettings& SettingsStore_Get();
+
+// Schedule a save of the given fields; repeated calls within the debounce
+// window collapse into one write
+void SettingsStore_MarkDirty(uint32_t fields);
+
+// Write anything still pending and stop the writer
+void SettingsStore_Shutdown();
@@ -0,0 +1,120 @@
+// ============================================================================
+// UI Icon Atlas
+// ============================================================================
+// Packs every UI icon into a single texture with the rect packer ImGui already
+// vendors, so consecutive ImGui::Image / ImageButton calls share one texture
+// and ImGui can merge them into one draw command.
+
+#include "textureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// imgui_draw.cpp compiles its own static copy; this one is private to us
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+// Empty border around each icon. A multiple of 4 keeps every icon on a
+// 4-pixel grid, so mip levels 0..2 never blend neighbouring icons.
+static constexpr int ICON_PADDING = 4;
+static constexpr int ATLAS_MAX_MIP = 2;
+static constexpr int ATLAS_MAX_SIZE = 4096;
+
+static AtlasRegion regions[ICON_COUNT];
+
+static int AlignUp4(int v)
+{
+    return (v + 3) & ~3;
+}
+
+// ----------------------------------------------------------------------------
+// Try to pack all rects into width x height; true if everything fit
+// ----------------------------------------------------------------------------
+static bool TryPack(std::vector<stbrp_rect>& rects, int width, int height)
+{
+    std::vector<stbrp_node> nodes((size_t)width);
+    stbrp_context ctx;
+    stbrp_init_target(&ctx, width, height, nodes.data(), (int)nodes.size());
+    return stbrp_pack_rects(&ctx, rects.data(), (int)rects.size()) == 1;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+bool Atlas_Build(const std::vector<DecodedImage>& icons)
+{
+    if (icons.size() != ICON_COUNT) {
+        std::cerr << "[Atlas] Expected " << ICON_COUNT << " icons, got " << icons.size() << "\n";
+        return false;
+    }
+
+    std::vector<stbrp_rect> rects(ICON_COUNT);
+    for (int i = 0; i < ICON_COUNT; ++i)
+    {
+        rects[i] = {};
+        rects[i].id = i;
+        rects[i].w = AlignUp4(icons[i].width + ICON_PADDING * 2);
+        rects[i].h = AlignUp4(icons[i].height + ICON_PADDING * 2);
+    }
+
+    // Grow the atlas (alternating width / height) until everything fits
+    int width = 256, height = 256;
+    while (!TryPack(rects, width, height))
+    {
+        if (width > height) height *= 2;
+        else width *= 2;
+
+        if (width > ATLAS_MAX_SIZE || height > ATLAS_MAX_SIZE) {
+            std::cerr << "[Atlas] Icons do not fit in " << ATLAS_MAX_SIZE << "px\n";
+            return false;
+        }
+    }
+
+    // Blit each icon into its slot
+    DecodedImage atlas;
+    atlas.name = "[ui atlas]";
+    atlas.width = atlas.srcWidth = width;
+    atlas.height = atlas.srcHeight = height;
+    atlas.pixels.assign((size_t)width * height * 4, 0);
+
+    for (const stbrp_rect& r : rects)
+    {
+        const DecodedImage& icon = icons[r.id];
+        int x0 = r.x + ICON_PADDING;
+        int y0 = r.y + ICON_PADDING;
+
+        for (int y = 0; y < icon.height; ++y) {
+            std::memcpy(
+                &atlas.pixels[((size_t)(y0 + y) * width + x0) * 4],
+                icon.Bytes() + (size_t)y * icon.width * 4,
+                (size_t)icon.width * 4);
+        }
+
+        AtlasRegion& region = regions[r.id];
+        region.uv0 = ImVec2(x0 / (float)width, y0 / (float)height);
+        region.uv1 = ImVec2((x0 + icon.width) / (float)width, (y0 + icon.height) / (float)height);
+        region.size = ImVec2((float)icon.srcWidth, (float)icon.srcHeight);
+    }
+
+    GLuint tex = Texture_Upload(atlas, ATLAS_MAX_MIP);
+    if (tex == 0) return false;
+
+    for (AtlasRegion& region : regions) {
+        region.texture = tex;
+    }
+
+    std::cout << "[Atlas] Packed " << ICON_COUNT << " icons into "
+        << width << "x" << height << "\n";
+    return true;
+}
+
+const AtlasRegion& Atlas_Get(UiIcon icon)
+{
+    return regions[icon];
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <glad/glad.h>
+#include "imgui.h"
+
+#include <vector>
+
+#include "loadTexture.h"
+
+// UI icons packed into the shared atlas (order = AssetManifest::icons)
+enum UiIcon {
+    ICON_WEATHER,
+    ICON_ARROW,
+    ICON_START,
+    ICON_STOP,
+    ICON_PAUSE,
+    ICON_RESET,
+    ICON_COUNT
+};
+
+// Where one icon lives inside the atlas texture
+struct AtlasRegion {
+    GLuint texture = 0;
+    ImVec2 uv0 = ImVec2(0, 0);
+    ImVec2 uv1 = ImVec2(1, 1);
+    ImVec2 size = ImVec2(0, 0);     // source image size (for layout)
+};
+
+// Pack the decoded icons into one texture and upload it (GL thread).
+// icons must hold ICON_COUNT images in UiIcon order.
+bool Atlas_Build(const std::vector<DecodedImage>& icons);
+
+// UV rectangle + texture for an icon (texture is 0 if the build failed)
+const AtlasRegion& Atlas_Get(UiIcon icon);
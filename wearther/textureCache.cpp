@@ -0,0 +1,258 @@
+// ============================================================================
+// Decoded Texture Cache
+// ============================================================================
+// Warm starts skip stb_image entirely: each entry holds the final RGBA8 mip
+// chain behind a small header and is memory-mapped read-only, so the upload
+// reads straight from the page cache.
+
+// Platform headers first: windows.h must see APIENTRY before glad does
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "textureCache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+static const char* CACHE_DIR = "cache/textures";
+
+static constexpr uint32_t CACHE_MAGIC = 0x5854434B;    // "KCTX"
+static constexpr uint32_t CACHE_VERSION = 1;
+
+struct TextureCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    int64_t srcMtime;       // source last_write_time (file clock ticks)
+    uint64_t srcSize;       // source size in bytes
+    int32_t srcWidth;
+    int32_t srcHeight;
+    int32_t width;
+    int32_t height;
+    int32_t levels;         // mip levels stored back to back after the header
+    uint32_t reserved;
+};
+
+// ============================================================================
+// READ-ONLY FILE MAPPING
+// ============================================================================
+
+struct MappedFile {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap((void*)data, size);
+#endif
+    }
+};
+
+static std::shared_ptr<MappedFile> MapFile(const fs::path& path)
+{
+    auto mf = std::make_shared<MappedFile>();
+
+#ifdef _WIN32
+    mf->file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mf->file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(mf->file, &size) || size.QuadPart == 0) return nullptr;
+
+    mf->mapping = CreateFileMappingW(mf->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mf->mapping) return nullptr;
+
+    mf->data = (const unsigned char*)MapViewOfFile(mf->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!mf->data) return nullptr;
+    mf->size = (size_t)size.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return nullptr;
+
+    mf->data = (const unsigned char*)p;
+    mf->size = (size_t)st.st_size;
+#endif
+
+    return mf;
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// FNV-1a over the request (path + display size + mip flag)
+// ----------------------------------------------------------------------------
+static uint64_t HashRequest(const char* filename, int displayWidth, int displayHeight, bool mipmaps)
+{
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](const void* bytes, size_t n) {
+        const unsigned char* p = (const unsigned char*)bytes;
+        for (size_t i = 0; i < n; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+    };
+
+    mix(filename, std::char_traits<char>::length(filename));
+    mix(&displayWidth, sizeof(displayWidth));
+    mix(&displayHeight, sizeof(displayHeight));
+    mix(&mipmaps, sizeof(mipmaps));
+    return h;
+}
+
+static fs::path CachePath(const char* filename, int displayWidth, int displayHeight, bool mipmaps)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.tex",
+        (unsigned long long)HashRequest(filename, displayWidth, displayHeight, mipmaps));
+    return fs::path(CACHE_DIR) / name;
+}
+
+// ----------------------------------------------------------------------------
+// Source identity used to validate an entry
+// ----------------------------------------------------------------------------
+static bool SourceStamp(const char* filename, int64_t& mtime, uint64_t& size)
+{
+    std::error_code ec;
+    auto time = fs::last_write_time(filename, ec);
+    if (ec) return false;
+    auto bytes = fs::file_size(filename, ec);
+    if (ec) return false;
+
+    mtime = (int64_t)time.time_since_epoch().count();
+    size = (uint64_t)bytes;
+    return true;
+}
+
+static size_t MipChainBytes(int width, int height, int levels)
+{
+    size_t total = 0;
+    for (int i = 0; i < levels; ++i) {
+        total += (size_t)width * height * 4;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return total;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+bool TextureCache_Load(const char* filename, int displayWidth, int displayHeight,
+    bool mipmaps, DecodedImage& out)
+{
+    int64_t mtime = 0;
+    uint64_t size = 0;
+    if (!SourceStamp(filename, mtime, size)) return false;
+
+    std::shared_ptr<MappedFile> mf =
+        MapFile(CachePath(filename, displayWidth, displayHeight, mipmaps));
+    if (!mf || mf->size < sizeof(TextureCacheHeader)) return false;
+
+    TextureCacheHeader header;
+    std::memcpy(&header, mf->data, sizeof(header));
+
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION) return false;
+    if (header.srcMtime != mtime || header.srcSize != size) return false;
+    if (header.width <= 0 || header.height <= 0 || header.levels <= 0) return false;
+
+    size_t payload = MipChainBytes(header.width, header.height, header.levels);
+    if (mf->size < sizeof(header) + payload) return false;
+
+    out.name = filename;
+    out.srcWidth = header.srcWidth;
+    out.srcHeight = header.srcHeight;
+    out.width = header.width;
+    out.height = header.height;
+    out.levels = header.levels;
+    out.pixels.clear();
+    out.mapped = mf->data + sizeof(header);
+    out.mappedSize = payload;
+    out.mapping = std::move(mf);
+    return true;
+}
+
+void TextureCache_Store(const char* filename, int displayWidth, int displayHeight,
+    bool mipmaps, const DecodedImage& image)
+{
+    TextureCacheHeader header{};
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.srcWidth = image.srcWidth;
+    header.srcHeight = image.srcHeight;
+    header.width = image.width;
+    header.height = image.height;
+    header.levels = image.levels;
+
+    if (!SourceStamp(filename, header.srcMtime, header.srcSize)) return;
+
+    std::error_code ec;
+    fs::create_directories(CACHE_DIR, ec);
+
+    fs::path path = CachePath(filename, displayWidth, displayHeight, mipmaps);
+    fs::path temp = path;
+    temp += ".tmp";
+
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)image.Bytes(), (std::streamsize)image.ByteSize());
+        if (!file) {
+            file.close();
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+
+    fs::rename(temp, path, ec);
+    if (ec) {
+        std::cerr << "[TextureCache] Failed to write " << path.string() << "\n";
+        fs::remove(temp, ec);
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "loadTexture.h"
+
+// On-disk cache of decoded, downsampled and mipmapped images.
+// Entries are keyed by source path + requested display size + mip flag and
+// validated against the source file's size and modification time, so
+// editing an asset invalidates its entry automatically.
+
+// Map a valid cache entry into out (no decoding). False on miss or mismatch.
+bool TextureCache_Load(const char* filename, int displayWidth, int displayHeight,
+    bool mipmaps, DecodedImage& out);
+
+// Write an entry for a freshly decoded image (temp file + rename)
+void TextureCache_Store(const char* filename, int displayWidth, int displayHeight,
+    bool mipmaps, const DecodedImage& image);
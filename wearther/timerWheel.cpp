@@ -0,0 +1,378 @@
+// ============================================================================
+// Hierarchical Timer Wheel
+// ============================================================================
+// Five levels of slots over a 1 ms tick: level 0 has 256 slots (one per tick),
+// levels 1-4 have 64 slots each covering 256, 16K, 1M and 64M ticks. A timer
+// goes into the coarsest level that still separates it from "now"; when
+// level 0 wraps, the next level-1 slot is redistributed (cascaded) downwards.
+// Slots are intrusive doubly-linked lists over a node pool, so insert and
+// cancel are O(1). Occupancy bitmaps give the next tick that fires or
+// cascades anything, so Advance jumps straight there instead of walking
+// every millisecond, and an idle app sleeps until then.
+
+#include "timerWheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+// ============================================================================
+// LAYOUT
+// ============================================================================
+
+static constexpr int LEVELS = 5;
+static constexpr int L0_BITS = 8;
+static constexpr int LN_BITS = 6;
+static constexpr int L0_SLOTS = 1 << L0_BITS;      // 256
+static constexpr int LN_SLOTS = 1 << LN_BITS;      // 64
+
+static constexpr uint64_t MAX_DELTA = (1ull << (L0_BITS + LN_BITS * (LEVELS - 1))) - 1;
+
+static constexpr int NONE = -1;
+
+struct TimerNode {
+    uint64_t expires = 0;       // tick
+    uint64_t repeat = 0;        // ticks, 0 = one-shot
+    int prev = NONE;
+    int next = NONE;
+    int level = NONE;           // NONE = not linked into the wheel
+    int slot = 0;
+    uint32_t generation = 1;
+    bool active = false;
+    TimerCallback callback;
+    std::string name;
+};
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+static std::vector<TimerNode> nodes;
+static std::vector<int> freeNodes;
+
+static int heads[LEVELS][L0_SLOTS];
+static uint64_t occupied[LEVELS][L0_SLOTS / 64];    // bit per non-empty slot
+
+static TimerClock::time_point epoch;
+static uint64_t currentTick = 0;    // next tick to process
+static bool initialized = false;
+
+static TimerWheelStats stats;
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static void EnsureInit()
+{
+    if (initialized) return;
+
+    epoch = TimerClock::now();
+    for (auto& level : heads) {
+        std::fill(std::begin(level), std::end(level), NONE);
+    }
+    initialized = true;
+}
+
+static uint64_t TickCeil(TimerClock::time_point t)
+{
+    if (t <= epoch) return 0;
+    auto ms = std::chrono::ceil<std::chrono::milliseconds>(t - epoch).count();
+    return (uint64_t)ms;
+}
+
+static uint64_t TickFloor(TimerClock::time_point t)
+{
+    if (t <= epoch) return 0;
+    auto ms = std::chrono::floor<std::chrono::milliseconds>(t - epoch).count();
+    return (uint64_t)ms;
+}
+
+static TimerClock::time_point TickTime(uint64_t tick)
+{
+    return epoch + std::chrono::milliseconds(tick);
+}
+
+static TimerId MakeId(int index)
+{
+    return ((TimerId)nodes[index].generation << 32) | (TimerId)(index + 1);
+}
+
+// Node for an id, or NONE if the id is stale
+static int Resolve(TimerId id)
+{
+    int index = (int)(id & 0xFFFFFFFFu) - 1;
+    if (index < 0 || index >= (int)nodes.size()) return NONE;
+    if (nodes[index].generation != (uint32_t)(id >> 32)) return NONE;
+    return nodes[index].active ? index : NONE;
+}
+
+static void Link(int index)
+{
+    TimerNode& n = nodes[index];
+    if (n.expires < currentTick) n.expires = currentTick;
+
+    uint64_t delta = std::min(n.expires - currentTick, MAX_DELTA);
+    uint64_t expires = currentTick + delta;
+
+    int level = 0;
+    int slot = 0;
+    if (delta < L0_SLOTS) {
+        slot = (int)(expires & (L0_SLOTS - 1));
+    }
+    else {
+        level = 1;
+        int shift = L0_BITS;
+        while (level < LEVELS - 1 && delta >= (1ull << (shift + LN_BITS))) {
+            ++level;
+            shift += LN_BITS;
+        }
+        slot = (int)((expires >> shift) & (LN_SLOTS - 1));
+    }
+
+    n.level = level;
+    n.slot = slot;
+    n.prev = NONE;
+    n.next = heads[level][slot];
+    if (n.next != NONE) nodes[n.next].prev = index;
+    heads[level][slot] = index;
+    occupied[level][slot >> 6] |= 1ull << (slot & 63);
+}
+
+static void Unlink(int index)
+{
+    TimerNode& n = nodes[index];
+    if (n.level == NONE) return;
+
+    if (n.prev != NONE) nodes[n.prev].next = n.next;
+    else heads[n.level][n.slot] = n.next;
+    if (n.next != NONE) nodes[n.next].prev = n.prev;
+
+    if (heads[n.level][n.slot] == NONE) {
+        occupied[n.level][n.slot >> 6] &= ~(1ull << (n.slot & 63));
+    }
+
+    n.level = NONE;
+    n.prev = n.next = NONE;
+}
+
+static void Release(int index)
+{
+    TimerNode& n = nodes[index];
+    n.active = false;
+    n.callback = nullptr;
+    n.name.clear();
+    n.generation++;
+    freeNodes.push_back(index);
+    stats.active--;
+}
+
+// ----------------------------------------------------------------------------
+// Move every timer in one upper-level slot down to where it now belongs
+// ----------------------------------------------------------------------------
+static void CascadeSlot(int level, int slot)
+{
+    int index = heads[level][slot];
+    heads[level][slot] = NONE;
+    occupied[level][slot >> 6] &= ~(1ull << (slot & 63));
+
+    while (index != NONE)
+    {
+        int next = nodes[index].next;
+        nodes[index].level = NONE;
+        Link(index);
+        stats.cascaded++;
+        index = next;
+    }
+}
+
+// Called when level 0 wraps at currentTick
+static void Cascade()
+{
+    int shift = L0_BITS;
+    for (int level = 1; level < LEVELS; ++level, shift += LN_BITS)
+    {
+        int slot = (int)((currentTick >> shift) & (LN_SLOTS - 1));
+        CascadeSlot(level, slot);
+        if (slot != 0) break;   // the level above only wraps when this one does
+    }
+}
+
+// ----------------------------------------------------------------------------
+// First occupied level-0 slot at or after `from` within this rotation
+// (returns L0_SLOTS if none)
+// ----------------------------------------------------------------------------
+static int NextOccupiedL0(int from)
+{
+    for (int word = from >> 6; word < L0_SLOTS / 64; ++word)
+    {
+        uint64_t bits = occupied[0][word];
+        if (word == (from >> 6)) bits &= ~0ull << (from & 63);
+        if (bits) return word * 64 + std::countr_zero(bits);
+    }
+    return L0_SLOTS;
+}
+
+// ----------------------------------------------------------------------------
+// Next tick (>= currentTick) at which Advance has work: a level-0 slot fires,
+// or an occupied upper-level slot cascades. UINT64_MAX if the wheel is empty.
+// ----------------------------------------------------------------------------
+static uint64_t NextEventTick()
+{
+    uint64_t best = UINT64_MAX;
+
+    // Level 0: later in this rotation, else the earlier slots hold the next one
+    int slot = (int)(currentTick & (L0_SLOTS - 1));
+    uint64_t rotation = currentTick - slot;
+    int next = NextOccupiedL0(slot);
+    if (next < L0_SLOTS) {
+        best = rotation + (uint64_t)next;
+    }
+    else {
+        next = NextOccupiedL0(0);
+        if (next < slot) best = rotation + L0_SLOTS + (uint64_t)next;
+    }
+
+    // Level n slot s cascades at the first multiple of its span whose slot
+    // index is s; rotating the bitmap to the next boundary's slot makes the
+    // trailing zero count the number of spans until then
+    int shift = L0_BITS;
+    for (int level = 1; level < LEVELS; ++level, shift += LN_BITS)
+    {
+        uint64_t bits = occupied[level][0];
+        if (!bits) continue;
+
+        uint64_t span = 1ull << shift;
+        uint64_t boundary = (currentTick + span - 1) & ~(span - 1);
+        int first = (int)((boundary >> shift) & (LN_SLOTS - 1));
+        uint64_t spans = (uint64_t)std::countr_zero(std::rotr(bits, first));
+        best = std::min(best, boundary + (spans << shift));
+    }
+    return best;
+}
+
+// ----------------------------------------------------------------------------
+// Fire everything in the level-0 slot for currentTick
+// ----------------------------------------------------------------------------
+static void Expire()
+{
+    int slot = (int)(currentTick & (L0_SLOTS - 1));
+
+    // Pop one at a time: callbacks may add or cancel timers, even this slot's
+    while (heads[0][slot] != NONE)
+    {
+        int index = heads[0][slot];
+        Unlink(index);
+
+        TimerId id = MakeId(index);
+        stats.fired++;
+
+        // Moved out: the callback may add timers and grow (move) the pool
+        TimerCallback callback = std::move(nodes[index].callback);
+        if (callback) callback(id);
+
+        // Re-resolve: the callback may have cancelled it
+        if (Resolve(id) == NONE) continue;
+
+        TimerNode& n = nodes[index];
+        if (n.repeat > 0) {
+            n.callback = std::move(callback);
+            n.expires += n.repeat;
+            Link(index);
+        }
+        else {
+            Release(index);
+        }
+    }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+TimerId Timers_AddAt(const char* name, TimerClock::time_point deadline,
+    TimerCallback callback, TimerClock::duration repeat)
+{
+    EnsureInit();
+
+    int index;
+    if (!freeNodes.empty()) {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        index = (int)nodes.size();
+        nodes.emplace_back();
+    }
+
+    TimerNode& n = nodes[index];
+    n.expires = TickCeil(deadline);
+    n.repeat = repeat > TimerClock::duration::zero()
+        ? std::max<uint64_t>(1, (uint64_t)std::chrono::ceil<std::chrono::milliseconds>(repeat).count())
+        : 0;
+    n.active = true;
+    n.callback = std::move(callback);
+    n.name = name ? name : "";
+    Link(index);
+
+    stats.active++;
+    return MakeId(index);
+}
+
+TimerId Timers_Add(const char* name, TimerClock::duration delay,
+    TimerCallback callback, TimerClock::duration repeat)
+{
+    return Timers_AddAt(name, TimerClock::now() + delay, std::move(callback), repeat);
+}
+
+bool Timers_Cancel(TimerId id)
+{
+    int index = Resolve(id);
+    if (index == NONE) return false;
+
+    Unlink(index);
+    Release(index);
+    return true;
+}
+
+bool Timers_IsActive(TimerId id)
+{
+    return Resolve(id) != NONE;
+}
+
+void Timers_Advance(TimerClock::time_point now)
+{
+    EnsureInit();
+    uint64_t target = TickFloor(now);
+
+    while (currentTick <= target)
+    {
+        // Jump over ticks with nothing to fire or cascade (wraps whose
+        // upper-level slots are empty included)
+        currentTick = std::min(NextEventTick(), target + 1);
+        if (currentTick > target) break;
+
+        if ((currentTick & (L0_SLOTS - 1)) == 0) {
+            Cascade();
+        }
+        Expire();
+        currentTick++;
+    }
+}
+
+TimerClock::time_point Timers_NextDue()
+{
+    EnsureInit();
+    if (stats.active == 0) return TimerClock::time_point::max();
+
+    // A timer still in an upper level is due no earlier than its slot's
+    // cascade, so a 25 minute session wakes the app once per level on the
+    // way down rather than at every level-0 wrap
+    uint64_t tick = NextEventTick();
+    if (tick == UINT64_MAX) return TimerClock::time_point::max();
+    return TickTime(tick);
+}
+
+TimerWheelStats Timers_GetStats()
+{
+    return stats;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Hierarchical timing wheel for any number of concurrent named timers
+// (Pomodoro sessions, break reminders, alarms, ...). Insert and cancel are
+// O(1); advancing costs O(timers fired + slots cascaded), independent of how
+// many timers are pending or how long the app was idle.
+//
+// UI-thread only: callbacks run inside Timers_Advance, on the caller's thread.
+
+using TimerId = uint64_t;                       // 0 = invalid
+using TimerCallback = std::function<void(TimerId)>;
+using TimerClock = std::chrono::steady_clock;
+
+// Fire once at `deadline` (never early; 1 ms resolution). A non-zero
+// `repeat` re-arms the timer at deadline + repeat, deadline + 2*repeat, ...
+TimerId Timers_AddAt(const char* name, TimerClock::time_point deadline,
+    TimerCallback callback, TimerClock::duration repeat = TimerClock::duration::zero());
+
+TimerId Timers_Add(const char* name, TimerClock::duration delay,
+    TimerCallback callback, TimerClock::duration repeat = TimerClock::duration::zero());
+
+// Safe from inside a callback, including on the timer being dispatched.
+// Returns false if the timer already fired (one-shot) or was cancelled.
+bool Timers_Cancel(TimerId id);
+
+bool Timers_IsActive(TimerId id);
+
+// Dispatch every timer due at or before `now`
+void Timers_Advance(TimerClock::time_point now);
+
+// Earliest time the wheel needs Timers_Advance again: the next deadline, or
+// the cascade of the upper-level slot holding it (early, never late).
+// time_point::max() when nothing is pending.
+TimerClock::time_point Timers_NextDue();
+
+struct TimerWheelStats
+{
+    size_t active = 0;
+    uint64_t fired = 0;
+    uint64_t cascaded = 0;      // timers moved down a level
+};
+TimerWheelStats Timers_GetStats();
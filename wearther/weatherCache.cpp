@@ -0,0 +1,206 @@
+// ============================================================================
+// Persistent Weather Cache
+// ============================================================================
+// Layout (little-endian, native widths):
+//   header | location | current conditions | hour count | five hourly arrays
+// Strings are a uint32 length followed by the bytes.
+
+#include "weatherCache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char* CACHE_DIR = "cache";
+static const char* CACHE_FILE = "cache/weather.bin";
+
+static constexpr uint32_t CACHE_MAGIC = 0x52485457;    // "WTHR"
+static constexpr uint32_t CACHE_VERSION = 1;
+
+// Refuse absurd counts from a corrupt file (a year of hours)
+static constexpr uint32_t MAX_HOURS = 24 * 366;
+
+// ============================================================================
+// SERIALIZATION HELPERS
+// ============================================================================
+
+struct ByteWriter
+{
+    std::vector<unsigned char> bytes;
+
+    template <typename T>
+    void Put(const T& v)
+    {
+        const unsigned char* p = (const unsigned char*)&v;
+        bytes.insert(bytes.end(), p, p + sizeof(T));
+    }
+
+    void PutString(const std::string& s)
+    {
+        Put((uint32_t)s.size());
+        bytes.insert(bytes.end(), s.begin(), s.end());
+    }
+
+    template <typename T>
+    void PutArray(const std::vector<T>& v)
+    {
+        const unsigned char* p = (const unsigned char*)v.data();
+        bytes.insert(bytes.end(), p, p + v.size() * sizeof(T));
+    }
+};
+
+struct ByteReader
+{
+    const unsigned char* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+
+    bool Take(void* dst, size_t n)
+    {
+        if (!ok || size - pos < n) {
+            ok = false;
+            return false;
+        }
+        std::memcpy(dst, data + pos, n);
+        pos += n;
+        return true;
+    }
+
+    template <typename T>
+    T Get()
+    {
+        T v{};
+        Take(&v, sizeof(T));
+        return v;
+    }
+
+    std::string GetString()
+    {
+        uint32_t n = Get<uint32_t>();
+        if (!ok || size - pos < n) {
+            ok = false;
+            return {};
+        }
+        std::string s((const char*)data + pos, n);
+        pos += n;
+        return s;
+    }
+
+    template <typename T>
+    void GetArray(std::vector<T>& v, size_t count)
+    {
+        v.resize(count);
+        Take(v.data(), count * sizeof(T));
+    }
+};
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+bool WeatherCache_Load(WeatherSnapshot& out)
+{
+    std::ifstream file(CACHE_FILE, std::ios::binary);
+    if (!file) return false;
+
+    std::vector<unsigned char> bytes(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ByteReader in{ bytes.data(), bytes.size() };
+    if (in.Get<uint32_t>() != CACHE_MAGIC || in.Get<uint32_t>() != CACHE_VERSION) {
+        return false;
+    }
+
+    WeatherSnapshot snap;
+    snap.geoFetchedAt = in.Get<int64_t>();
+    snap.weatherFetchedAt = in.Get<int64_t>();
+
+    snap.location.lat = in.Get<double>();
+    snap.location.lon = in.Get<double>();
+    snap.location.city = in.GetString();
+    snap.location.timezone = in.GetString();
+    snap.location.valid = true;
+
+    snap.weather.temp = in.Get<double>();
+    snap.weather.wind = in.Get<double>();
+    snap.weather.code = in.Get<int32_t>();
+    snap.weather.time = in.Get<int64_t>();
+    snap.weather.valid = true;
+
+    uint32_t hours = in.Get<uint32_t>();
+    if (!in.ok || hours > MAX_HOURS) return false;
+
+    in.GetArray(snap.hourly.time, hours);
+    in.GetArray(snap.hourly.temperature, hours);
+    in.GetArray(snap.hourly.wind, hours);
+    in.GetArray(snap.hourly.humidity, hours);
+    in.GetArray(snap.hourly.code, hours);
+    if (!in.ok) {
+        std::cerr << "[WeatherCache] " << CACHE_FILE << " is truncated, ignoring\n";
+        return false;
+    }
+
+    snap.valid = true;
+    snap.fromCache = true;
+    out = std::move(snap);
+    return true;
+}
+
+void WeatherCache_Save(const WeatherSnapshot& snapshot)
+{
+    const HourlyForecast& h = snapshot.hourly;
+
+    ByteWriter out;
+    out.Put(CACHE_MAGIC);
+    out.Put(CACHE_VERSION);
+    out.Put((int64_t)snapshot.geoFetchedAt);
+    out.Put((int64_t)snapshot.weatherFetchedAt);
+
+    out.Put(snapshot.location.lat);
+    out.Put(snapshot.location.lon);
+    out.PutString(snapshot.location.city);
+    out.PutString(snapshot.location.timezone);
+
+    out.Put(snapshot.weather.temp);
+    out.Put(snapshot.weather.wind);
+    out.Put((int32_t)snapshot.weather.code);
+    out.Put((int64_t)snapshot.weather.time);
+
+    out.Put((uint32_t)h.Count());
+    out.PutArray(h.time);
+    out.PutArray(h.temperature);
+    out.PutArray(h.wind);
+    out.PutArray(h.humidity);
+    out.PutArray(h.code);
+
+    std::error_code ec;
+    fs::create_directories(CACHE_DIR, ec);
+
+    fs::path path = CACHE_FILE;
+    fs::path temp = path;
+    temp += ".tmp";
+
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        file.write((const char*)out.bytes.data(), (std::streamsize)out.bytes.size());
+        if (!file) {
+            file.close();
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+
+    fs::rename(temp, path, ec);
+    if (ec) {
+        std::cerr << "[WeatherCache] Failed to write " << CACHE_FILE << "\n";
+        fs::remove(temp, ec);
+    }
+}
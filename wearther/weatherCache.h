@@ -0,0 +1,13 @@
+#pragma once
+
+#include "weatherFetch.h"
+
+// Last successful snapshot, persisted in a small binary file so the Weather
+// tab has real data on the first frame. The snapshot's geoFetchedAt and
+// weatherFetchedAt stamps travel with it; the caller decides what is stale.
+
+// Read the cache into out (strip not built). False if missing or invalid.
+bool WeatherCache_Load(WeatherSnapshot& out);
+
+// Write the snapshot (temp file + rename, so a crash never leaves half a file)
+void WeatherCache_Save(const WeatherSnapshot& snapshot);
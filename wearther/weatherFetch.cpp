@@ -0,0 +1,273 @@
+// ============================================================================
+// Background Weather / Geolocation Fetch Worker
+// ============================================================================
+// Owns every blocking HTTP call so the frame loop never waits on the network.
+// Results are published as immutable snapshots through an atomic shared_ptr
+// swap; the UI keeps drawing the previous snapshot while a refresh is in
+// flight or after a failed one (stale-while-revalidate).
+
+#include "weatherFetch.h"
+#include "weatherCache.h"
+#include "weatherProvider.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// ============================================================================
+// WORKER STATE
+// ============================================================================
+
+static std::atomic<std::shared_ptr<const WeatherSnapshot>> latestSnapshot{
+    std::make_shared<const WeatherSnapshot>()
+};
+
+static std::atomic<bool> refreshing{ false };
+
+// Created in Start, destroyed in Stop; used by the worker in between
+static std::unique_ptr<WeatherProvider> provider;
+
+static std::mutex statsMutex;
+static WeatherFetchStats stats;
+
+// User event pushed after each publish (0 = not registered)
+static Uint32 publishedEventType = 0;
+
+static std::thread worker;
+static std::mutex wakeMutex;
+static std::condition_variable wakeCv;
+static bool stopRequested = false;
+
+// Retry sooner than the normal cadence when a refresh fails
+static constexpr double RETRY_SECONDS = 10.0;
+
+// An IP's location changes far less often than the weather does
+static constexpr double GEO_TTL_SECONDS = 60.0 * 60.0;
+
+// Worker-only: parse target reused across refreshes
+static HourlyForecast parsedHourly;
+
+// Worker-only: last good geolocation and when it was looked up (wall clock,
+// so the age survives a restart through the disk cache)
+static GeoLocation cachedGeo;
+static int64_t geoFetchedAt = 0;
+
+// ----------------------------------------------------------------------------
+// Cached geolocation; looked up again only once the TTL has passed. A failed
+// lookup keeps using the previous location if there is one.
+// ----------------------------------------------------------------------------
+static const GeoLocation& CurrentLocation()
+{
+    int64_t now = (int64_t)std::time(nullptr);
+    if (cachedGeo.valid && now - geoFetchedAt < GEO_TTL_SECONDS) {
+        return cachedGeo;
+    }
+
+    GeoLocation fresh = provider->Locate();
+    if (fresh.valid && (fresh.lat != 0.0 || fresh.lon != 0.0)) {
+        cachedGeo = std::move(fresh);
+        geoFetchedAt = now;
+    }
+    return cachedGeo;
+}
+
+// ----------------------------------------------------------------------------
+// Swap in a snapshot and wake the UI thread if it is idling in
+// SDL_WaitEventTimeout
+// ----------------------------------------------------------------------------
+static void Publish(std::shared_ptr<const WeatherSnapshot> snapshot)
+{
+    latestSnapshot.store(std::move(snapshot));
+
+    if (publishedEventType != 0) {
+        SDL_Event ev{};
+        ev.type = publishedEventType;
+        SDL_PushEvent(&ev);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// One refresh: location (cached), then weather. Returns false if no location
+// is known or the forecast request failed, in which case the previous
+// snapshot stays published and the disk cache keeps the last good one.
+// ----------------------------------------------------------------------------
+static bool RefreshOnce()
+{
+    const GeoLocation& pos = CurrentLocation();
+    if (!pos.valid) {
+        return false;
+    }
+
+    auto next = std::make_shared<WeatherSnapshot>();
+    next->location = pos;
+    next->weather = provider->Forecast(pos.lat, pos.lon, &parsedHourly);
+    if (!next->weather.valid) {
+        return false;
+    }
+
+    next->hourly = parsedHourly;
+    Forecast_BuildStrip(next->hourly, next->weather.time, next->strip);
+    next->geoFetchedAt = geoFetchedAt;
+    next->weatherFetchedAt = (int64_t)std::time(nullptr);
+    next->valid = true;
+
+    if (provider->UsesDiskCache()) {
+        WeatherCache_Save(*next);
+    }
+    Publish(std::move(next));
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Publish the disk cache, if any. Returns how long the first network refresh
+// can wait (0 = the cached forecast has already expired).
+// ----------------------------------------------------------------------------
+static double PublishCached(double refreshSeconds)
+{
+    auto cached = std::make_shared<WeatherSnapshot>();
+    if (!WeatherCache_Load(*cached)) {
+        return 0.0;
+    }
+
+    int64_t now = (int64_t)std::time(nullptr);
+    int64_t age = now - cached->weatherFetchedAt;
+
+    // The strip starts at the current hour, not the hour it was fetched in
+    Forecast_BuildStrip(cached->hourly, cached->weather.time + age, cached->strip);
+
+    cachedGeo = cached->location;
+    geoFetchedAt = cached->geoFetchedAt;
+
+    std::cout << "[Weather] Loaded cached forecast for " << cached->location.city
+        << " (" << age << " s old)\n";
+    Publish(std::move(cached));
+
+    if (age < 0) return 0.0;    // clock went backwards; just refresh
+    return age < refreshSeconds ? refreshSeconds - (double)age : 0.0;
+}
+
+static void RecordRefresh(double ms, bool ok)
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+
+    stats.refreshes++;
+    if (!ok) stats.failures++;
+    stats.lastMs = ms;
+    stats.minMs = stats.refreshes == 1 ? ms : std::min(stats.minMs, ms);
+    stats.maxMs = std::max(stats.maxMs, ms);
+    stats.meanMs += (ms - stats.meanMs) / stats.refreshes;
+
+    std::cout << "[Weather] Refresh " << (ok ? "took " : "failed after ") << ms
+        << " ms (mean " << stats.meanMs << ", max " << stats.maxMs << ")\n";
+}
+
+static void FetchLoop(double refreshSeconds, double firstWait)
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+
+    // Cached data is still fresh: sleep out the rest of its TTL first
+    if (firstWait > 0.0) {
+        wakeCv.wait_for(lock, std::chrono::duration<double>(firstWait),
+            [] { return stopRequested; });
+    }
+
+    while (!stopRequested)
+    {
+        lock.unlock();
+
+        refreshing = true;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = false;
+        try {
+            ok = RefreshOnce();
+        }
+        catch (const std::exception& ex) {
+            std::cout << "[Weather] Refresh error: " << ex.what() << "\n";
+        }
+        refreshing = false;
+        RecordRefresh(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count(), ok);
+
+        if (!ok) {
+            std::cout << "[Weather] Refresh failed, keeping previous data\n";
+        }
+
+        lock.lock();
+
+        double wait = ok ? refreshSeconds : RETRY_SECONDS;
+        wakeCv.wait_for(lock, std::chrono::duration<double>(wait),
+            [] { return stopRequested; });
+    }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void WeatherFetch_Start(double refreshSeconds)
+{
+    WeatherFetch_StartWith(WeatherProvider_FromEnvironment(), refreshSeconds);
+}
+
+void WeatherFetch_StartWith(std::unique_ptr<WeatherProvider> source, double refreshSeconds)
+{
+    if (worker.joinable()) return;
+
+    if (publishedEventType == 0) {
+        Uint32 type = SDL_RegisterEvents(1);
+        publishedEventType = (type == (Uint32)-1) ? 0 : type;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopRequested = false;
+    }
+
+    provider = std::move(source);
+    std::cout << "[Weather] Using " << provider->Name() << " provider\n";
+
+    // Read on this thread so the very first frame already has data
+    double firstWait = provider->UsesDiskCache() ? PublishCached(refreshSeconds) : 0.0;
+
+    worker = std::thread(FetchLoop, refreshSeconds, firstWait);
+}
+
+void WeatherFetch_Stop()
+{
+    if (!worker.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopRequested = true;
+    }
+    wakeCv.notify_all();
+
+    // An in-flight request is bounded by the client timeouts in http.cpp
+    worker.join();
+    Http_ClosePool();
+    provider.reset();
+}
+
+std::shared_ptr<const WeatherSnapshot> WeatherFetch_Latest()
+{
+    return latestSnapshot.load();
+}
+
+bool WeatherFetch_IsRefreshing()
+{
+    return refreshing.load();
+}
+
+WeatherFetchStats WeatherFetch_GetStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}
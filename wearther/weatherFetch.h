@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "http.h"
+
+// Immutable result of one refresh. The worker builds a new snapshot per
+// refresh and swaps it in; the UI only ever reads a complete one.
+struct WeatherSnapshot
+{
+    GeoLocation location{};
+    climate weather{};
+    HourlyForecast hourly;      // full series, one array per variable
+    ForecastStrip strip;        // next hours, preformatted for the UI
+    int64_t geoFetchedAt = 0;       // wall-clock seconds (std::time)
+    int64_t weatherFetchedAt = 0;
+    bool fromCache = false;     // loaded from disk at startup, not yet refreshed
+    bool valid = false;
+};
+
+class WeatherProvider;
+
+// Start / stop the background fetch worker (call once from main, after
+// SDL_Init). The data source comes from WeatherProvider_FromEnvironment().
+// Start publishes the on-disk cache first, if any, and the first network
+// refresh waits until that data is older than refreshSeconds. Each
+// published snapshot also pushes an SDL event so an idle main loop wakes up
+// to draw it.
+void WeatherFetch_Start(double refreshSeconds = 60.0);
+void WeatherFetch_Stop();
+
+// Same, with the given provider instead of the environment's (benchmarks)
+void WeatherFetch_StartWith(std::unique_ptr<WeatherProvider> source, double refreshSeconds);
+
+// Latest published snapshot (never null, may be stale while refreshing)
+std::shared_ptr<const WeatherSnapshot> WeatherFetch_Latest();
+
+// True while the worker is inside a network round-trip
+bool WeatherFetch_IsRefreshing();
+
+// End-to-end refresh latency (location + forecast + parse + publish)
+struct WeatherFetchStats
+{
+    int refreshes = 0;
+    int failures = 0;
+    double lastMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    double meanMs = 0.0;
+};
+WeatherFetchStats WeatherFetch_GetStats();
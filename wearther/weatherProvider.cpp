@@ -0,0 +1,112 @@
+// ============================================================================
+// Weather Providers
+// ============================================================================
+// Both providers go through the same http.cpp calls and client pool; they
+// only differ in which hosts those calls talk to.
+
+#include "weatherProvider.h"
+#include "replayServer.h"
+
+#include <SDL.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// ============================================================================
+// ONLINE
+// ============================================================================
+
+class OnlineWeatherProvider : public WeatherProvider
+{
+public:
+    const char* Name() const override { return "online"; }
+
+    GeoLocation Locate() override
+    {
+        return GetGeoLocation(IP_API_HOST);
+    }
+
+    climate Forecast(double lat, double lon, HourlyForecast* hourly) override
+    {
+        return Getweather(OPEN_METEO_HOST, lat, lon, hourly);
+    }
+};
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+class ReplayWeatherProvider : public WeatherProvider
+{
+public:
+    explicit ReplayWeatherProvider(const std::string& host) : host(host) {}
+    ~ReplayWeatherProvider() override { ReplayServer_Stop(); }
+
+    const char* Name() const override { return "replay"; }
+    bool UsesDiskCache() const override { return false; }
+
+    GeoLocation Locate() override
+    {
+        return GetGeoLocation(host);
+    }
+
+    climate Forecast(double lat, double lon, HourlyForecast* hourly) override
+    {
+        return Getweather(host, lat, lon, hourly);
+    }
+
+private:
+    std::string host;
+};
+
+// ----------------------------------------------------------------------------
+// Environment helpers (SDL_getenv: portable and warning-free on MSVC)
+// ----------------------------------------------------------------------------
+static int EnvInt(const char* name, int fallback)
+{
+    const char* v = SDL_getenv(name);
+    return v ? std::atoi(v) : fallback;
+}
+
+static double EnvDouble(const char* name, double fallback)
+{
+    const char* v = SDL_getenv(name);
+    return v ? std::atof(v) : fallback;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+std::unique_ptr<WeatherProvider> WeatherProvider_CreateOnline()
+{
+    return std::make_unique<OnlineWeatherProvider>();
+}
+
+std::unique_ptr<WeatherProvider> WeatherProvider_CreateReplay()
+{
+    ReplayConfig config;
+    if (const char* dir = SDL_getenv("WEARTHER_REPLAY_DIR")) {
+        config.directory = dir;
+    }
+    config.latencyMs = EnvInt("WEARTHER_REPLAY_LATENCY_MS", 0);
+    config.jitterMs = EnvInt("WEARTHER_REPLAY_JITTER_MS", 0);
+    config.failureRate = EnvDouble("WEARTHER_REPLAY_FAIL_RATE", 0.0);
+
+    std::string host = ReplayServer_Start(config);
+    if (host.empty()) {
+        std::cerr << "[Weather] Replay server failed to start, using online provider\n";
+        return WeatherProvider_CreateOnline();
+    }
+    return std::make_unique<ReplayWeatherProvider>(host);
+}
+
+std::unique_ptr<WeatherProvider> WeatherProvider_FromEnvironment()
+{
+    const char* name = SDL_getenv("WEARTHER_PROVIDER");
+    if (name && std::strcmp(name, "replay") == 0) {
+        return WeatherProvider_CreateReplay();
+    }
+    return WeatherProvider_CreateOnline();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+
+#include "http.h"
+
+// Where the fetch worker gets its location and forecast from. Every call is
+// blocking and runs on the fetch worker only.
+class WeatherProvider
+{
+public:
+    virtual ~WeatherProvider() = default;
+
+    virtual const char* Name() const = 0;
+    virtual GeoLocation Locate() = 0;
+    virtual climate Forecast(double lat, double lon, HourlyForecast* hourly) = 0;
+
+    // Whether results are real enough to persist in / seed from the disk cache
+    virtual bool UsesDiskCache() const { return true; }
+};
+
+// ip-api.com + api.open-meteo.com
+std::unique_ptr<WeatherProvider> WeatherProvider_CreateOnline();
+
+// Same requests against the local replay server (started and stopped with
+// the provider). Settings come from the environment:
+//   WEARTHER_REPLAY_DIR         recorded responses (default "replay")
+//   WEARTHER_REPLAY_LATENCY_MS  delay added to each response
+//   WEARTHER_REPLAY_JITTER_MS   + uniform random 0..jitter
+//   WEARTHER_REPLAY_FAIL_RATE   0..1, fraction answered with HTTP 503
+std::unique_ptr<WeatherProvider> WeatherProvider_CreateReplay();
+
+// WEARTHER_PROVIDER=replay selects the replay provider, anything else online
+std::unique_ptr<WeatherProvider> WeatherProvider_FromEnvironment();